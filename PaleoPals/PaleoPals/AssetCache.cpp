@@ -0,0 +1,81 @@
+#include "AssetCache.h"
+#include <iostream>
+
+AssetCache& AssetCache::get()
+{
+    static AssetCache cache;
+    return cache;
+}
+
+template <typename T, typename LoadFunction>
+std::shared_ptr<T> AssetCache::acquire(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path, LoadFunction load)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Entry<T>& entry = entries[path];
+    ++entry.requests;
+
+    // still held by someone, share it
+    if (std::shared_ptr<T> existing = entry.asset.lock())
+    {
+        return existing;
+    }
+
+    auto asset = std::make_shared<T>();
+    ++entry.loads;
+
+    if (!load(*asset))
+    {
+        // not cached so the next request tries the file again
+        std::cerr << "AssetCache: failed to load " << path << "\n";
+        return asset;
+    }
+
+    entry.asset = asset;
+    return asset;
+}
+
+std::shared_ptr<sf::Texture> AssetCache::getTexture(const std::string& path)
+{
+    return acquire(m_textures, path, [&](sf::Texture& texture) { return texture.loadFromFile(path); });
+}
+
+std::shared_ptr<sf::Font> AssetCache::getFont(const std::string& path)
+{
+    return acquire(m_fonts, path, [&](sf::Font& font) { return font.openFromFile(path); });
+}
+
+long AssetCache::getTextureUseCount(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_textures.find(path);
+    return (it == m_textures.end()) ? 0 : it->second.asset.use_count();
+}
+
+long AssetCache::getFontUseCount(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_fonts.find(path);
+    return (it == m_fonts.end()) ? 0 : it->second.asset.use_count();
+}
+
+void AssetCache::printStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto printEntries = [](const char* label, const auto& entries)
+        {
+            std::cout << label << ":\n";
+            for (const auto& [path, entry] : entries)
+            {
+                std::cout << "  " << path << " | users " << entry.asset.use_count()
+                    << " | requests " << entry.requests << " | loads " << entry.loads << "\n";
+            }
+        };
+
+    std::cout << "--- Asset cache ---\n";
+    printEntries("Textures", m_textures);
+    printEntries("Fonts", m_fonts);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// One copy of every texture and font, looked up by file path. Everything that
+// draws with an asset holds a shared_ptr to it; the cache only keeps a weak_ptr,
+// so an asset is freed once the last user lets go and loaded again if asked for later.
+class AssetCache
+{
+public:
+    static AssetCache& get();
+
+    // never null, a failed load gives back an empty asset so sprites and text can still be built from it
+    std::shared_ptr<sf::Texture> getTexture(const std::string& path);
+    std::shared_ptr<sf::Font> getFont(const std::string& path);
+
+    // how many holders an asset currently has, 0 if it isn't loaded
+    long getTextureUseCount(const std::string& path) const;
+    long getFontUseCount(const std::string& path) const;
+
+    void printStats() const;
+
+private:
+    AssetCache() = default;
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    template <typename T>
+    struct Entry
+    {
+        std::weak_ptr<T> asset;
+        int requests = 0;       // every get, hit or miss
+        int loads = 0;          // times it actually came off disk
+    };
+
+    template <typename T, typename LoadFunction>
+    std::shared_ptr<T> acquire(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path, LoadFunction load);
+
+    std::unordered_map<std::string, Entry<sf::Texture>> m_textures;
+    std::unordered_map<std::string, Entry<sf::Font>> m_fonts;
+    mutable std::mutex m_mutex;
+};
+
+#endif // !ASSET_CACHE_H
@@ -0,0 +1,139 @@
+#include "AssetLoader.h"
+#include <iostream>
+#include <algorithm>
+
+AssetLoader::AssetLoader()
+{
+    // leave a core for the main thread, decoding a few dozen PNGs doesn't need more than four
+    unsigned int cores = std::thread::hardware_concurrency();
+    unsigned int workerCount = std::min(cores > 1 ? cores - 1 : 1u, 4u);
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_jobs.clear();
+    }
+    m_condition.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void AssetLoader::queueTexture(const std::string& path, sf::Texture& target, std::function<void(bool)> onUploaded)
+{
+    // reuse a finished slot so streaming textures in and out all session doesn't keep growing m_targets
+    int id;
+
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_targets[id] = { path, &target, std::move(onUploaded) };
+    }
+    else
+    {
+        id = static_cast<int>(m_targets.size());
+        m_targets.push_back({ path, &target, std::move(onUploaded) });
+    }
+    ++m_queuedCount;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back({ id, path });
+    }
+    m_condition.notify_one();
+}
+
+void AssetLoader::uploadPending(sf::Time budget)
+{
+    sf::Clock clock;
+
+    while (true)
+    {
+        DecodedImage decoded;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty())
+            {
+                return;
+            }
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        UploadTarget& target = m_targets[decoded.id];
+        bool uploaded = decoded.loaded && target.texture->loadFromImage(decoded.image);
+
+        if (!uploaded)
+        {
+            std::cerr << "AssetLoader: failed to load " << target.path << "\n";
+        }
+
+        // the callback may queue more textures, so take everything out of the slot before calling it
+        std::function<void(bool)> onUploaded = std::move(target.onUploaded);
+        target = UploadTarget();
+        m_freeIds.push_back(decoded.id);
+        ++m_uploadedCount;
+
+        if (onUploaded)
+        {
+            onUploaded(uploaded);
+        }
+
+        // GPU uploads are the part that stalls a frame, so stop once this frame's share is spent
+        if (clock.getElapsedTime() >= budget)
+        {
+            return;
+        }
+    }
+}
+
+float AssetLoader::getProgress() const
+{
+    if (m_queuedCount == 0)
+    {
+        return 1.f;
+    }
+
+    return static_cast<float>(m_uploadedCount) / static_cast<float>(m_queuedCount);
+}
+
+void AssetLoader::workerLoop()
+{
+    while (true)
+    {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+
+            if (m_stop)
+            {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        // PNG decoding is pure CPU work, no GL context needed
+        DecodedImage decoded;
+        decoded.id = job.id;
+        decoded.loaded = decoded.image.loadFromFile(job.path);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.push_back(std::move(decoded));
+    }
+}
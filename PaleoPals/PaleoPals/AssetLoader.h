@@ -0,0 +1,73 @@
+#pragma once
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Decodes image files to sf::Image on a small pool of worker threads. Finished
+// images wait until uploadPending() is called on the main thread, which copies
+// them into their textures until the frame's time budget is used up.
+class AssetLoader
+{
+public:
+    AssetLoader();
+    ~AssetLoader();
+
+    // target has to stay alive until it is uploaded, onUploaded runs on the main thread right after
+    void queueTexture(const std::string& path, sf::Texture& target, std::function<void(bool)> onUploaded = {});
+
+    // main thread only, always uploads at least one finished image if there is one
+    void uploadPending(sf::Time budget);
+
+    int getQueuedCount() const { return m_queuedCount; }
+    int getUploadedCount() const { return m_uploadedCount; }
+    float getProgress() const;
+    bool isFinished() const { return m_uploadedCount == m_queuedCount; }
+
+private:
+    struct Job
+    {
+        int id = 0;
+        std::string path;
+    };
+
+    struct DecodedImage
+    {
+        int id = 0;
+        bool loaded = false;
+        sf::Image image;
+    };
+
+    struct UploadTarget
+    {
+        std::string path;
+        sf::Texture* texture = nullptr;
+        std::function<void(bool)> onUploaded;
+    };
+
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+
+    // shared with the workers, guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Job> m_jobs;
+    std::deque<DecodedImage> m_decoded;
+    bool m_stop = false;
+
+    // main thread only
+    std::vector<UploadTarget> m_targets;    // indexed by job id
+    std::vector<int> m_freeIds;             // ids of uploaded targets, reused by the next queueTexture
+    int m_queuedCount = 0;
+    int m_uploadedCount = 0;
+};
+
+#endif // !ASSET_LOADER_H
@@ -1,72 +1,75 @@
 ﻿#include "BTCollectFossilNode.h"
 #include "NPC.h"
 #include "Map.h"
+#include <iostream>
 
-BTCollectFossilNode::BTCollectFossilNode(NPC& npc, Map& map) : m_npc(npc), m_map(map) {}
-
-BTStatus BTCollectFossilNode::tick(float dt)
+BTStatus tickCollectFossil(NPC& npc, Map& map, BTTickContext& context, CollectibleHandle& targetHandle)
 {
-    auto& fossils = m_map.getFossilManager().getAllCollectibles();
+    FossilManager& fossils = map.getFossilManager();
+
+    Collectible* target = fossils.get(targetHandle);
 
     // Pick a target if none or if the old one was collected
-    if (!m_currentTarget || m_currentTarget->isPickedUp)
+    if (!target)
     {
-        m_currentTarget = nullptr;
+        // fossils sealed off in another pocket are skipped outright instead of searched for
+        sf::Vector2i npcTile = map.worldToTile(npc.getNPCPosition());
 
-        float bestDistanceSq = std::numeric_limits<float>::max();
-        sf::Vector2f npcPos = m_npc.getNPCPosition();
-
-        for (auto& c : fossils)
-        {
-            if (!c.isPickedUp)
+        targetHandle = fossils.findNearest(npc.getNPCPosition(), 1.0e9f, [&](const Collectible& collectible)
             {
-                sf::Vector2f diff = c.sprite.getPosition() - npcPos;
-                float distSq = diff.x * diff.x + diff.y * diff.y;
-
-                if (distSq < bestDistanceSq)
-                {
-                    bestDistanceSq = distSq;
-                    m_currentTarget = &c;
-                }
-            }
-        }
+                return map.isReachable(npcTile, { collectible.gridCol, collectible.gridRow });
+            });
+        target = fossils.get(targetHandle);
 
         // Generate path to new target
-        if (m_currentTarget)
+        if (target)
         {
-            m_npc.generateFossilPath(m_map, { m_currentTarget->gridCol, m_currentTarget->gridRow });
+            npc.generateFossilPath(map, { target->gridCol, target->gridRow });
         }
     }
 
     // No fossils left → Success
-    if (!m_currentTarget)
+    if (!target)
     {
         return BTStatus::Success;
     }
 
     // Walk the path
-    m_npc.updateFossilPath(sf::seconds(dt), m_map);
+    npc.updateFossilPath(sf::seconds(context.dt), map);
+
+    // nothing to walk until the path service answers, the timeout is just a safety net
+    if (npc.getFossilTicket() != NO_PATH_TICKET)
+    {
+        context.yield.sleepFor = 0.5f;
+        context.yield.waitForEvent = true;
+        context.yield.event = BTEvent::PathReady;
+        context.yield.eventKey = npc.getFossilTicket();
+        return BTStatus::Running;
+    }
 
     // Check proximity to fossil
-    sf::Vector2f npcPos = m_npc.getNPCPosition();
-    sf::Vector2f fossilPos = m_currentTarget->sprite.getPosition();
+    sf::Vector2f npcPos = npc.getNPCPosition();
+    sf::Vector2f fossilPos = target->sprite.getPosition();
     sf::Vector2f diff = fossilPos - npcPos;
     float distSq = diff.x * diff.x + diff.y * diff.y;
 
     if (distSq < 16.0f * 16.0f)
     {
         // Reached fossil
-        m_currentTarget->isPickedUp = true;
-        m_currentTarget->sprite.setPosition(sf::Vector2f(-10000.f, -10000.f));
-        std::cout << "NPC collected fossil: " << m_currentTarget->collectibleIndex << std::endl;
+        std::cout << "NPC collected fossil: " << target->collectibleIndex << std::endl;
+        fossils.removeCollectible(targetHandle);
 
         // Reset path so next tick generates a new one
-        m_npc.m_fossilPath.clear();
-        m_npc.m_fossilIndex = 0;
-        m_currentTarget = nullptr;
+        npc.m_fossilPath.clear();
+        npc.m_fossilIndex = 0;
+        targetHandle = CollectibleHandle();
+    }
+    else if (!npc.hasFossilRoute())
+    {
+        // no path or it ran out short of the fossil, leave it for the next trip
+        targetHandle = CollectibleHandle();
+        return BTStatus::Success;
     }
 
     return BTStatus::Running; // keep running until all fossils are gone
 }
-
-
@@ -1,19 +1,9 @@
 #pragma once
 #include "BTNode.h"
+#include "Fossil.h"
 class NPC;
 class Map;
-struct Collectible;
 
-class BTCollectFossilNode : public BTNode
-{
-public:
-
-	BTCollectFossilNode(NPC& npc, Map& map);
-	BTStatus tick(float dt) override;
-
-private:
-
-	Collectible* m_currentTarget = nullptr;
-	NPC& m_npc;
-	Map& m_map;
-};
\ No newline at end of file
+// walks to the nearest reachable fossil and picks it up, target goes stale by itself if someone else gets there first
+// sleeps while its path is queued with the path service, succeeds if no path gets it there
+BTStatus tickCollectFossil(NPC& npc, Map& map, BTTickContext& context, CollectibleHandle& targetHandle);
\ No newline at end of file
@@ -2,41 +2,71 @@
 #include "NPC.h"
 #include "Map.h"
 
-BTMiningNode::BTMiningNode(NPC& npc, Map& map) : m_npc(npc), m_map(map) {}
-
-BTStatus BTMiningNode::tick(float dt)
+BTStatus tickMining(NPC& npc, Map& map, BTTickContext& context, BTSlot* state)
 {
-	if (m_npc.m_miningPath.empty() && !m_npc.m_returningToSurface)
+	float& cooldown = state[0].timer;
+	std::uint32_t& next = state[1].index;
+	std::uint32_t& count = state[2].index;
+	BTSlot* path = state + 3;
+
+	// plan the trip on the first tick, it lives in the blackboard until it's dug
+	if (count == 0)
 	{
-		m_npc.generateMiningPath(m_map);
+		sf::Vector2i tiles[MINING_PATH_LENGTH];
+		int planned = npc.planMiningPath(map, map.worldToTile(npc.getNPCPosition()), tiles, MINING_PATH_LENGTH);
+
+		if (planned == 0)
+		{
+			return BTStatus::Failure;
+		}
+
+		for (int i = 0; i < planned; ++i)
+		{
+			path[i].index = packTile(tiles[i]);
+		}
+
+		count = static_cast<std::uint32_t>(planned);
+		next = 0;
+		cooldown = 0.0f;
 	}
 
-	m_npc.updateMining(sf::seconds(dt), m_map);
+	// time spent asleep counts toward the next swing
+	cooldown -= context.elapsed;
 
-	if (m_npc.m_miningIndex < m_npc.m_miningPath.size())
+	if (next >= count)
 	{
-		return BTStatus::Running;
+		count = 0;
+		return BTStatus::Success;
 	}
 
-	if (m_npc.m_returningToSurface)
+	sf::Vector2i tile = unpackTile(path[next].index);
+
+	// If tile is still solid damage it over time
+	if (map.isSolid(tile.y, tile.x))
 	{
-		if (m_npc.m_returnPath.empty())
+		if (cooldown <= 0.f)
 		{
-			m_npc.generateReturnPath(m_map);
-
-			if (m_npc.m_returnPath.empty())
-			{
-				std::cout << "Mining node: return path empty, FAILING to reset tree\n";
-				m_npc.m_returningToSurface = false;
-				m_npc.m_miningPath.clear();
-				m_npc.m_miningIndex = 0;
-				m_npc.m_returnIndex = 0;
-				return BTStatus::Failure;  // Force tree to reset
-			}
+			npc.mineTile(map, tile);
+			cooldown = npc.npcMiningTickDelay;
 		}
-		return BTStatus::Success;
+
+		// stood at a solid tile waiting to swing again, sleep unless it breaks first
+		if (map.isSolid(tile.y, tile.x))
+		{
+			context.yield.sleepFor = cooldown;
+			context.yield.waitForEvent = true;
+			context.yield.event = BTEvent::TileBroken;
+			context.yield.eventKey = static_cast<std::uint32_t>(tile.y * map.getColumnCount() + tile.x);
+		}
+
+		return BTStatus::Running;
+	}
+
+	// Tile is broken move toward it
+	if (npc.walkToTile(tile, context.dt, map))
+	{
+		next++;
 	}
 
 	return BTStatus::Running;
 }
-
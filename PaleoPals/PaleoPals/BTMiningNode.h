@@ -1,17 +1,12 @@
 #pragma once
 #include "BTNode.h"
+#include "constants.h"
 class NPC;
 class Map;
 
-class BTMiningNode : public BTNode
-{
-public: 
+// slots: swing cooldown, index of the tile being dug, tiles in the trip, then the trip itself
+const int MINING_STATE_SLOTS = 3 + MINING_PATH_LENGTH;
 
-	BTMiningNode(NPC& npc, Map& map);
-	BTStatus tick(float dt) override;
-
-private:
-
-	NPC& m_npc;
-	Map& m_map;
-};
\ No newline at end of file
+// digs out a random trip from where the npc stands, succeeds once it's done
+// sleeps between swings at a solid tile, or until someone else breaks it
+BTStatus tickMining(NPC& npc, Map& map, BTTickContext& context, BTSlot* state);
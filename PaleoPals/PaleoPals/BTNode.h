@@ -1,6 +1,6 @@
 #pragma once
 #include <SFML/System.hpp>
-#include <iostream>
+#include <cstdint>
 
 enum class BTStatus
 {
@@ -9,9 +9,45 @@ enum class BTStatus
 	Running
 };
 
-class BTNode
+// things a sleeping agent can be woken by, each posted with a key saying which tile / ticket
+enum class BTEvent : std::uint8_t
 {
-public:
-	virtual ~BTNode() = default;
-	virtual BTStatus tick(float dt) = 0;
-};
\ No newline at end of file
+	TileBroken,		// key is row * columns + col
+	PathReady		// key is the PathTicket
+};
+
+// a running leaf can fill this in to say it has nothing to do for a while
+struct BTYield
+{
+	float sleepFor = 0.0f;		// 0 means tick again next frame, otherwise the longest it'll sleep
+	bool waitForEvent = false;	// also wake early if event / eventKey is posted
+	BTEvent event = BTEvent::TileBroken;
+	std::uint32_t eventKey = 0;
+};
+
+// one slot of an agent's blackboard, composites keep their running child here and leaves their timers / handles / tiles
+union BTSlot
+{
+	std::uint32_t index;
+	float timer;
+};
+
+// tiles kept in slots, row in the high half and column in the low half
+const std::uint32_t BT_NO_TILE = 0xFFFFFFFF;
+
+inline std::uint32_t packTile(sf::Vector2i tile)
+{
+	return (static_cast<std::uint32_t>(tile.y) << 16) | static_cast<std::uint32_t>(tile.x);
+}
+
+inline sf::Vector2i unpackTile(std::uint32_t packed)
+{
+	return sf::Vector2i(static_cast<int>(packed & 0xFFFF), static_cast<int>(packed >> 16));
+}
+
+struct BTTickContext
+{
+	float dt = 0.0f;		// this frame, used for moving
+	float elapsed = 0.0f;	// since this agent was last ticked, used for timers, bigger than dt after a sleep
+	BTYield yield;
+};
@@ -1,47 +1,50 @@
 #include "BTReturnToSurfaceNode.h"
 #include "NPC.h"
 #include "Map.h"
+#include <iostream>
 
-BTReturnToSurfaceNode::BTReturnToSurfaceNode(NPC& npc, Map& map) : m_npc(npc), m_map(map) {}
-
-BTStatus BTReturnToSurfaceNode::tick(float dt)
+BTStatus tickReturnToSurface(NPC& npc, Map& map, BTTickContext& context, BTSlot* state)
 {
-	// not in return state, fail to move to next behaviour
-	if (!m_npc.m_returningToSurface)
-	{
-		m_timeoutTimer = 0.0f;
-		return BTStatus::Failure;
-	}
+	float& stuckTimer = state[0].timer;
+	std::uint32_t& nextTile = state[1].index;
 
-	m_timeoutTimer += dt;
-
-	if (m_timeoutTimer > 10.0f && m_npc.m_returnPath.empty())
+	// pick the next step off the field, it's kept up to date as tiles open so nothing needs repairing
+	if (nextTile == BT_NO_TILE)
 	{
-		std::cout << "Return node TIMEOUT - NPC trapped underground for 10+ seconds!\n";
-
-		// Reset NPC state completely
-		m_npc.m_returningToSurface = false;
-		m_npc.m_miningPath.clear();
-		m_npc.m_returnPath.clear();
-		m_npc.m_miningIndex = 0;
-		m_npc.m_returnIndex = 0;
-		m_timeoutTimer = 0.f;
-
-		return BTStatus::Failure;  // Force tree to reset then try again
+		sf::Vector2i tile = map.worldToTile(npc.getNPCPosition());
+
+		if (tile.y <= 0 || map.getSurfaceDistance(tile.y, tile.x) == 0)
+		{
+			stuckTimer = 0.0f;
+			return BTStatus::Success;
+		}
+
+		sf::Vector2i next;
+
+		if (!map.stepTowardSurface(tile, next))
+		{
+			stuckTimer += context.elapsed;
+
+			if (stuckTimer > 10.0f)
+			{
+				std::cout << "Return node TIMEOUT - NPC trapped underground for 10+ seconds!\n";
+				stuckTimer = 0.0f;
+				return BTStatus::Failure;  // Force tree to reset then try again
+			}
+
+			// sealed in, give someone a chance to dig a way through
+			context.yield.sleepFor = 0.5f;
+			return BTStatus::Running;
+		}
+
+		stuckTimer = 0.0f;
+		nextTile = packTile(next);
 	}
 
-	m_npc.updateReturn(sf::seconds(dt), m_map);
-
-	if (m_npc.m_returnIndex >= m_npc.m_returnPath.size())
+	if (npc.walkToTile(unpackTile(nextTile), context.dt, map))
 	{
-		m_npc.m_returningToSurface = false; 
-		m_npc.m_miningPath.clear();
-		m_npc.m_returnPath.clear();
-		m_npc.m_miningIndex = 0;
-		m_npc.m_returnIndex = 0;
-		m_timeoutTimer = 0.f;
-		return BTStatus::Success;
+		nextTile = BT_NO_TILE;
 	}
-	return BTStatus::Running;
 
-}
\ No newline at end of file
+	return BTStatus::Running;
+}
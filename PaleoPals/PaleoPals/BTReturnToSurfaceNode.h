@@ -3,16 +3,8 @@
 class NPC;
 class Map;
 
-class BTReturnToSurfaceNode : public BTNode
-{
-public:
+// slots: stuck timer, tile currently being walked to
+const int RETURN_STATE_SLOTS = 2;
 
-	BTReturnToSurfaceNode(NPC& npc, Map& map);
-	BTStatus tick(float dt) override;
-
-private:
-
-	NPC& m_npc;
-	Map& m_map;
-	float m_timeoutTimer = 0.0f;
-};
\ No newline at end of file
+// climbs the surface distance field a tile at a time, gives up after 10 seconds sealed in
+BTStatus tickReturnToSurface(NPC& npc, Map& map, BTTickContext& context, BTSlot* state);
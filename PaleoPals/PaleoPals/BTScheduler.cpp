@@ -0,0 +1,175 @@
+#include "BTScheduler.h"
+#include <algorithm>
+
+namespace
+{
+    // alarms this close to now go off this frame rather than the next one
+    const double WAKE_TOLERANCE = 1.0e-4;
+}
+
+std::uint64_t BTScheduler::makeEventKey(BTEvent event, std::uint32_t key)
+{
+    return (static_cast<std::uint64_t>(event) << 32) | key;
+}
+
+void BTScheduler::addAgent()
+{
+    AgentSchedule agent;
+    agent.lastTick = m_time;
+    m_agents.push_back(agent);
+
+    m_awake.push_back(static_cast<int>(m_agents.size()) - 1);
+}
+
+void BTScheduler::insertAgent(int index)
+{
+    if (index >= static_cast<int>(m_agents.size()))
+    {
+        addAgent();
+        return;
+    }
+
+    AgentSchedule agent;
+    agent.lastTick = m_time;
+    m_agents.insert(m_agents.begin() + index, agent);
+
+    // every alarm and event after index now points at the wrong agent, hiring is rare enough to just start over
+    wakeAll();
+}
+
+void BTScheduler::resize(int count)
+{
+    AgentSchedule agent;
+    agent.lastTick = m_time;
+    m_agents.resize(count, agent);
+
+    wakeAll();
+}
+
+void BTScheduler::wakeAll()
+{
+    m_alarms = {};
+    m_waiting.clear();
+    m_awake.clear();
+    m_sleeping = 0;
+
+    for (int i = 0; i < static_cast<int>(m_agents.size()); ++i)
+    {
+        m_agents[i].asleep = false;
+        m_agents[i].waitingForEvent = false;
+        m_agents[i].sleepId++;
+        m_awake.push_back(i);
+    }
+}
+
+void BTScheduler::wake(int agent)
+{
+    AgentSchedule& schedule = m_agents[agent];
+
+    if (!schedule.asleep)
+        return;
+
+    // woken by the alarm, stop listening for the event
+    if (schedule.waitingForEvent)
+    {
+        auto range = m_waiting.equal_range(schedule.eventKey);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == agent)
+            {
+                m_waiting.erase(it);
+                break;
+            }
+        }
+
+        schedule.waitingForEvent = false;
+    }
+
+    schedule.asleep = false;
+    schedule.sleepId++;
+    --m_sleeping;
+
+    m_awake.push_back(agent);
+}
+
+const std::vector<int>& BTScheduler::collectDue()
+{
+    while (!m_alarms.empty() && m_alarms.top().wakeAt <= m_time + WAKE_TOLERANCE)
+    {
+        Alarm alarm = m_alarms.top();
+        m_alarms.pop();
+
+        if (alarm.agent < static_cast<int>(m_agents.size()) && m_agents[alarm.agent].sleepId == alarm.sleepId)
+        {
+            wake(alarm.agent);
+        }
+    }
+
+    m_due.swap(m_awake);
+    m_awake.clear();
+
+    // walk the blackboards front to back
+    std::sort(m_due.begin(), m_due.end());
+
+    return m_due;
+}
+
+float BTScheduler::beginTick(int agent)
+{
+    AgentSchedule& schedule = m_agents[agent];
+
+    float elapsed = static_cast<float>(m_time - schedule.lastTick);
+    schedule.lastTick = m_time;
+
+    return elapsed;
+}
+
+void BTScheduler::endTick(int agent, const BTYield& yield)
+{
+    if (yield.sleepFor <= 0.f && !yield.waitForEvent)
+    {
+        m_awake.push_back(agent);
+        return;
+    }
+
+    AgentSchedule& schedule = m_agents[agent];
+    schedule.asleep = true;
+    schedule.sleepId++;
+    ++m_sleeping;
+
+    if (yield.sleepFor > 0.f)
+    {
+        m_alarms.push({ m_time + yield.sleepFor, agent, schedule.sleepId });
+    }
+
+    if (yield.waitForEvent)
+    {
+        schedule.waitingForEvent = true;
+        schedule.eventKey = makeEventKey(yield.event, yield.eventKey);
+        m_waiting.emplace(schedule.eventKey, agent);
+    }
+}
+
+void BTScheduler::post(BTEvent event, std::uint32_t key)
+{
+    auto range = m_waiting.equal_range(makeEventKey(event, key));
+
+    if (range.first == range.second)
+        return;
+
+    m_posted.clear();
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        m_agents[it->second].waitingForEvent = false;
+        m_posted.push_back(it->second);
+    }
+
+    m_waiting.erase(range.first, range.second);
+
+    for (int agent : m_posted)
+    {
+        wake(agent);
+    }
+}
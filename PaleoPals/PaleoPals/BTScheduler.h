@@ -0,0 +1,72 @@
+#pragma once
+#ifndef BT_SCHEDULER_H
+#define BT_SCHEDULER_H
+
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <cstdint>
+#include "BTNode.h"
+
+// Picks which agents get their tree ticked each frame. An agent whose running leaf yields
+// is put to sleep until its wake time comes round or the event it asked for is posted,
+// and costs nothing until then. Agents are indices into WorkerManager's worker list.
+class BTScheduler
+{
+public:
+    // new agents start awake, inserting shifts every index after it so everyone is woken
+    void addAgent();
+    void insertAgent(int index);
+    void resize(int count);
+
+    void advance(float dt) { m_time += dt; }
+
+    // agents to tick this frame in index order, sleepers whose time is up included
+    const std::vector<int>& collectDue();
+
+    // seconds since the agent was last ticked
+    float beginTick(int agent);
+    // an empty yield keeps the agent awake for next frame
+    void endTick(int agent, const BTYield& yield);
+
+    // wakes every agent sleeping on this event and key
+    void post(BTEvent event, std::uint32_t key);
+
+    int getAgentCount() const { return static_cast<int>(m_agents.size()); }
+    int getSleepingCount() const { return m_sleeping; }
+
+private:
+    struct AgentSchedule
+    {
+        double lastTick = 0.0;
+        std::uint32_t sleepId = 0;      // bumped on every sleep / wake so old alarms are ignored
+        bool asleep = false;
+        bool waitingForEvent = false;
+        std::uint64_t eventKey = 0;
+    };
+
+    struct Alarm
+    {
+        double wakeAt;
+        int agent;
+        std::uint32_t sleepId;
+
+        bool operator>(const Alarm& other) const { return wakeAt > other.wakeAt; }
+    };
+
+    static std::uint64_t makeEventKey(BTEvent event, std::uint32_t key);
+
+    void wake(int agent);
+    void wakeAll();
+
+    std::vector<AgentSchedule> m_agents;
+    std::priority_queue<Alarm, std::vector<Alarm>, std::greater<Alarm>> m_alarms;
+    std::unordered_multimap<std::uint64_t, int> m_waiting;     // event key -> agents asleep on it
+    std::vector<int> m_awake;      // ticked next frame
+    std::vector<int> m_due;
+    std::vector<int> m_posted;
+    double m_time = 0.0;
+    int m_sleeping = 0;
+};
+
+#endif // !BT_SCHEDULER_H
@@ -2,30 +2,27 @@
 #include "NPC.h"
 #include "Map.h"
 
-BTWanderSurfaceNode::BTWanderSurfaceNode(NPC& npc, Map& map) :m_npc(npc), m_map(map) {}
-
-BTStatus BTWanderSurfaceNode::tick(float dt)
+BTStatus tickWanderSurface(NPC& npc, Map& map, BTTickContext& context, float& timer)
 {
-	if (m_npc.m_returningToSurface)
-	{
-		return BTStatus::Failure;	// dont trigger mining while returning
-	}
+	npc.m_wandering = true;
 
-	m_npc.updateSurfaceWandering(sf::seconds(dt), m_map);
+	timer += context.elapsed;
 
-	m_timer += dt;
-
-	if (m_timer > 1.0f)
+	if (timer >= 1.0f)
 	{
-		m_timer = 0.0f;
+		timer = 0.0f;
 		int roll = std::rand() % 100;
 
 		if (roll< 30)
 		{
+			npc.m_wandering = false;
 			return BTStatus::Success;
 		}
 	}
 
+	// nothing to decide until the next roll
+	context.yield.sleepFor = 1.0f - timer;
+
 	return BTStatus::Running;
 }
 
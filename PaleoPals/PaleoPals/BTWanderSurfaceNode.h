@@ -3,16 +3,6 @@
 class NPC;
 class Map;
 
-class BTWanderSurfaceNode : public BTNode
-{
-public:
-
-	BTWanderSurfaceNode(NPC& npc, Map& map);
-	BTStatus tick(float dt) override;
-
-private:
-
-	NPC& m_npc;
-	Map& m_map;
-	float m_timer = 0.0f;
-};
\ No newline at end of file
+// strolls along the surface, succeeds now and then to send the npc digging
+// the npc walks by itself in updateNPC, so this sleeps until the next roll
+BTStatus tickWanderSurface(NPC& npc, Map& map, BTTickContext& context, float& timer);
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include "BehaviourTree.h"
+#include "BTWanderSurfaceNode.h"
+#include "BTMiningNode.h"
+#include "BTReturnToSurfaceNode.h"
+#include "BTCollectFossilNode.h"
+#include "NPC.h"
+#include "Map.h"
+#include <fstream>
+#include <iostream>
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    struct NodeName
+    {
+        const char* name;
+        BTNodeType type;
+    };
+
+    const NodeName NODE_NAMES[] =
+    {
+        { "Sequence", BTNodeType::Sequence },
+        { "Selector", BTNodeType::Selector },
+        { "WanderSurface", BTNodeType::WanderSurface },
+        { "Mining", BTNodeType::Mining },
+        { "ReturnToSurface", BTNodeType::ReturnToSurface },
+        { "CollectFossil", BTNodeType::CollectFossil }
+    };
+
+    bool isComposite(BTNodeType type)
+    {
+        return type == BTNodeType::Sequence || type == BTNodeType::Selector;
+    }
+
+    // slots each node needs in an agent's blackboard
+    int stateSlots(BTNodeType type)
+    {
+        switch (type)
+        {
+        case BTNodeType::Sequence:
+        case BTNodeType::Selector:
+        case BTNodeType::WanderSurface:
+            return 1;
+        case BTNodeType::ReturnToSurface:
+            return RETURN_STATE_SLOTS;
+        case BTNodeType::Mining:
+            return MINING_STATE_SLOTS;
+        case BTNodeType::CollectFossil:
+            return 2;   // handle index + generation
+        default:
+            return 0;
+        }
+    }
+
+    bool parseDefinition(const json& node, BTDefinition& definition, const std::string& path)
+    {
+        if (!node.is_object() || !node.contains("type") || !node["type"].is_string())
+        {
+            std::cout << "Behaviour tree " << path << ": every node needs a \"type\"\n";
+            return false;
+        }
+
+        std::string type = node["type"].get<std::string>();
+        bool known = false;
+
+        for (const NodeName& entry : NODE_NAMES)
+        {
+            if (type == entry.name)
+            {
+                definition.type = entry.type;
+                known = true;
+                break;
+            }
+        }
+
+        if (!known)
+        {
+            std::cout << "Behaviour tree " << path << ": unknown node type " << type << "\n";
+            return false;
+        }
+
+        if (!isComposite(definition.type))
+            return true;
+
+        if (!node.contains("children") || !node["children"].is_array() || node["children"].empty())
+        {
+            std::cout << "Behaviour tree " << path << ": " << type << " needs at least one child\n";
+            return false;
+        }
+
+        for (const json& child : node["children"])
+        {
+            definition.children.emplace_back();
+
+            if (!parseDefinition(child, definition.children.back(), path))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+BehaviourTree::BehaviourTree()
+{
+    compile(defaultDefinition());
+}
+
+BTDefinition BehaviourTree::defaultDefinition()
+{
+    BTDefinition miningSequence;
+    miningSequence.type = BTNodeType::Sequence;
+    miningSequence.children = {
+        { BTNodeType::WanderSurface, {} },
+        { BTNodeType::Mining, {} },
+        { BTNodeType::ReturnToSurface, {} },
+        { BTNodeType::CollectFossil, {} },
+        { BTNodeType::ReturnToSurface, {} }
+    };
+
+    BTDefinition rootSelector;
+    rootSelector.type = BTNodeType::Selector;
+    rootSelector.children.push_back(miningSequence);
+
+    return rootSelector;
+}
+
+bool BehaviourTree::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path);
+
+    if (!file.is_open())
+    {
+        std::cout << "Behaviour tree " << path << " not found, using the default tree\n";
+        compile(defaultDefinition());
+        return false;
+    }
+
+    json data = json::parse(file, nullptr, false);
+    BTDefinition root;
+
+    if (data.is_discarded() || !parseDefinition(data, root, path))
+    {
+        std::cout << "Behaviour tree " << path << " is invalid, using the default tree\n";
+        compile(defaultDefinition());
+        return false;
+    }
+
+    compile(root);
+    return true;
+}
+
+void BehaviourTree::compile(const BTDefinition& root)
+{
+    m_nodes.clear();
+    m_children.clear();
+    m_stateSize = 0;
+
+    m_root = compileNode(root);
+}
+
+int BehaviourTree::compileNode(const BTDefinition& definition)
+{
+    int index = static_cast<int>(m_nodes.size());
+
+    CompiledNode node;
+    node.type = definition.type;
+    node.firstChild = 0;
+    node.childCount = 0;
+    node.stateSlot = static_cast<std::uint16_t>(m_stateSize);
+    m_nodes.push_back(node);
+
+    m_stateSize += stateSlots(definition.type);
+
+    if (!isComposite(definition.type))
+        return index;
+
+    // children are compiled first so their indices can go into m_children side by side
+    std::vector<std::uint16_t> childIndices;
+    for (const BTDefinition& child : definition.children)
+    {
+        childIndices.push_back(static_cast<std::uint16_t>(compileNode(child)));
+    }
+
+    m_nodes[index].firstChild = static_cast<std::uint16_t>(m_children.size());
+    m_nodes[index].childCount = static_cast<std::uint16_t>(childIndices.size());
+    m_children.insert(m_children.end(), childIndices.begin(), childIndices.end());
+
+    return index;
+}
+
+void BehaviourTree::initState(BTSlot* state) const
+{
+    for (const CompiledNode& node : m_nodes)
+    {
+        switch (node.type)
+        {
+        case BTNodeType::WanderSurface:
+            state[node.stateSlot].timer = 0.f;
+            break;
+        case BTNodeType::ReturnToSurface:
+            state[node.stateSlot].timer = 0.f;
+            state[node.stateSlot + 1].index = BT_NO_TILE;
+            break;
+        case BTNodeType::CollectFossil:
+            state[node.stateSlot].index = CollectibleHandle::INVALID_INDEX;
+            state[node.stateSlot + 1].index = 0;
+            break;
+        case BTNodeType::Sequence:
+        case BTNodeType::Selector:
+            state[node.stateSlot].index = 0;
+            break;
+        case BTNodeType::Mining:
+            state[node.stateSlot].timer = 0.f;
+            state[node.stateSlot + 1].index = 0;
+            state[node.stateSlot + 2].index = 0;    // no trip planned yet
+            break;
+        }
+    }
+}
+
+BTStatus BehaviourTree::tick(NPC& npc, Map& map, BTSlot* state, BTTickContext& context) const
+{
+    context.yield = BTYield();
+
+    if (m_nodes.empty())
+        return BTStatus::Failure;
+
+    return tickNode(m_root, npc, map, state, context);
+}
+
+BTStatus BehaviourTree::tickNode(int index, NPC& npc, Map& map, BTSlot* state, BTTickContext& context) const
+{
+    const CompiledNode& node = m_nodes[index];
+
+    switch (node.type)
+    {
+    case BTNodeType::Sequence:
+    {
+        BTSlot& slot = state[node.stateSlot];
+
+        while (slot.index < node.childCount)
+        {
+            BTStatus status = tickNode(m_children[node.firstChild + slot.index], npc, map, state, context);
+
+            if (status == BTStatus::Running)    // return running if still busy
+                return BTStatus::Running;
+
+            // the next child is starting fresh, it didn't sleep through any of the elapsed time
+            context.elapsed = context.dt;
+
+            if (status == BTStatus::Failure)    // return fail if one child doesnt succeed
+            {
+                slot.index = 0;
+                return BTStatus::Failure;
+            }
+
+            slot.index++;    // go to next child
+        }
+
+        slot.index = 0;
+        return BTStatus::Success;    // every child succeeded
+    }
+
+    case BTNodeType::Selector:
+    {
+        BTSlot& slot = state[node.stateSlot];
+
+        while (slot.index < node.childCount)
+        {
+            BTStatus status = tickNode(m_children[node.firstChild + slot.index], npc, map, state, context);
+
+            if (status == BTStatus::Running)    // still busy
+                return BTStatus::Running;
+
+            context.elapsed = context.dt;
+
+            if (status == BTStatus::Success)    // if succeeds, entire selector succeeds
+            {
+                slot.index = 0;
+                return BTStatus::Success;
+            }
+
+            slot.index++;
+        }
+
+        slot.index = 0;
+        return BTStatus::Failure;    // every child failed
+    }
+
+    case BTNodeType::WanderSurface:
+        return tickWanderSurface(npc, map, context, state[node.stateSlot].timer);
+
+    case BTNodeType::Mining:
+        return tickMining(npc, map, context, state + node.stateSlot);
+
+    case BTNodeType::ReturnToSurface:
+        return tickReturnToSurface(npc, map, context, state + node.stateSlot);
+
+    case BTNodeType::CollectFossil:
+    {
+        CollectibleHandle target{ state[node.stateSlot].index, state[node.stateSlot + 1].index };
+        BTStatus status = tickCollectFossil(npc, map, context, target);
+        state[node.stateSlot].index = target.index;
+        state[node.stateSlot + 1].index = target.generation;
+        return status;
+    }
+    }
+
+    return BTStatus::Failure;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef BEHAVIOUR_TREE_H
+#define BEHAVIOUR_TREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "BTNode.h"
+
+class NPC;
+class Map;
+
+enum class BTNodeType : std::uint8_t
+{
+    Sequence,
+    Selector,
+    WanderSurface,
+    Mining,
+    ReturnToSurface,
+    CollectFossil
+};
+
+// a tree as written, before it's flattened
+struct BTDefinition
+{
+    BTNodeType type = BTNodeType::Sequence;
+    std::vector<BTDefinition> children;
+};
+
+// A behaviour tree compiled once into a flat array of nodes and shared by every worker.
+// Nothing in it belongs to an agent, each agent passes in its own blackboard of
+// getStateSize() slots along with the NPC and Map to act on, so many agents can keep
+// their state packed together and be ticked in one loop.
+class BehaviourTree
+{
+public:
+    BehaviourTree();
+
+    // falls back to the default tree and returns false if the file can't be used
+    bool loadFromFile(const std::string& path);
+    void compile(const BTDefinition& root);
+
+    // wander -> dig -> come back up -> grab fossils -> come back up, forever
+    static BTDefinition defaultDefinition();
+
+    int getStateSize() const { return m_stateSize; }
+    int getNodeCount() const { return static_cast<int>(m_nodes.size()); }
+
+    void initState(BTSlot* state) const;
+    // context.yield comes back filled in if the running leaf wants its agent put to sleep
+    BTStatus tick(NPC& npc, Map& map, BTSlot* state, BTTickContext& context) const;
+
+private:
+    struct CompiledNode
+    {
+        BTNodeType type;
+        std::uint16_t firstChild;   // into m_children, composites only
+        std::uint16_t childCount;
+        std::uint16_t stateSlot;
+    };
+
+    int compileNode(const BTDefinition& definition);
+    BTStatus tickNode(int index, NPC& npc, Map& map, BTSlot* state, BTTickContext& context) const;
+
+    std::vector<CompiledNode> m_nodes;
+    std::vector<std::uint16_t> m_children;  // child node indices, each composite's are contiguous
+    int m_root = 0;
+    int m_stateSize = 0;
+};
+
+#endif // !BEHAVIOUR_TREE_H
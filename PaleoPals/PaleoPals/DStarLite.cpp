@@ -0,0 +1,332 @@
+#include "DStarLite.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+namespace
+{
+    const int ROW_STEP[4] = { 0, 0, 1, -1 };
+    const int COL_STEP[4] = { 1, -1, 0, 0 };
+}
+
+bool DStarLite::plan(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+    clear();
+
+    if (start.x < 0 || start.y < 0 || start.y >= grid.rows || start.x >= grid.cols)
+        return false;
+    if (!grid.isOpen(goal.y, goal.x))
+        return false;
+
+    // the band of rows around both ends is all this search ever looks at
+    m_firstRow = std::max(0, std::min(start.y, goal.y) - DSTAR_WINDOW_MARGIN);
+    m_rows = std::min(grid.rows, std::max(start.y, goal.y) + DSTAR_WINDOW_MARGIN + 1) - m_firstRow;
+    m_cols = grid.cols;
+    prepare(m_rows * m_cols);
+
+    m_start = start;
+    m_lastStart = start;
+    m_goal = goal;
+    m_startCell = toCell(start.y, start.x);
+    m_goalCell = toCell(goal.y, goal.x);
+    m_active = true;
+
+    track(m_goalCell);
+    m_rhs[m_goalCell] = 0;
+    push(m_goalCell);
+
+    computeShortestPath(grid);
+
+    return getCell(m_startCell).g < INF;
+}
+
+bool DStarLite::repair(const SolidGridView& grid, sf::Vector2i start, const std::vector<sf::Vector2i>& opened)
+{
+    m_lastExpanded = 0;
+
+    if (!m_active || grid.cols != m_cols || !inWindow(start.y, start.x))
+        return false;
+
+    // keys already queued were made for the old start, km keeps them a valid lower bound
+    m_keyModifier += std::abs(start.x - m_lastStart.x) + std::abs(start.y - m_lastStart.y);
+    m_lastStart = start;
+    m_start = start;
+    m_startCell = toCell(start.y, start.x);
+
+    // opening a tile adds the edges from each neighbour into it, so the neighbours need their
+    // rhs redone as well as the tile itself, which may never have been looked at while solid
+    for (const sf::Vector2i& tile : opened)
+    {
+        if (!isOpen(grid, tile.y, tile.x))
+            continue;
+
+        int cell = toCell(tile.y, tile.x);
+        updateVertex(grid, cell);
+        updatePredecessors(grid, cell);
+    }
+
+    // a start we haven't looked at yet needs its rhs before the search can stop on it
+    if (!isTracked(m_startCell))
+        updateVertex(grid, m_startCell);
+
+    computeShortestPath(grid);
+
+    return getCell(m_startCell).g < INF;
+}
+
+bool DStarLite::extractPath(const SolidGridView& grid, std::vector<sf::Vector2i>& path) const
+{
+    path.clear();
+
+    if (!m_active || getCell(m_startCell).g >= INF)
+        return false;
+
+    int current = m_startCell;
+    size_t limit = static_cast<size_t>(m_rows) * m_cols;
+
+    while (current != m_goalCell)
+    {
+        int row = rowOf(current);
+        int col = current % m_cols;
+        int best = -1;
+        int bestCost = INF;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextRow = row + ROW_STEP[i];
+            int nextCol = col + COL_STEP[i];
+
+            if (!isOpen(grid, nextRow, nextCol))
+                continue;
+
+            int next = toCell(nextRow, nextCol);
+            int cost = getCell(next).g;
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best = next;
+            }
+        }
+
+        // every step goes downhill so this only trips if the values are broken
+        if (best < 0 || path.size() > limit)
+        {
+            path.clear();
+            return false;
+        }
+
+        path.push_back(sf::Vector2i(best % m_cols, rowOf(best)));
+        current = best;
+    }
+
+    return true;
+}
+
+void DStarLite::clear()
+{
+    // the arrays are kept, plan() moves the stamp on so nothing in them counts any more
+    m_open.clear();
+    m_keyModifier = 0;
+    m_active = false;
+    m_lastExpanded = 0;
+}
+
+DStarLite::Cell DStarLite::getCell(int cell) const
+{
+    return isTracked(cell) ? Cell{ m_g[cell], m_rhs[cell] } : Cell{ INF, INF };
+}
+
+void DStarLite::track(int cell)
+{
+    if (isTracked(cell))
+        return;
+
+    m_stamp[cell] = m_generation;
+    m_g[cell] = INF;
+    m_rhs[cell] = INF;
+}
+
+void DStarLite::prepare(int cellCount)
+{
+    if (static_cast<int>(m_stamp.size()) < cellCount)
+    {
+        m_g.resize(cellCount);
+        m_rhs.resize(cellCount);
+        m_stamp.resize(cellCount, 0);
+    }
+
+    // stamps only need clearing when the counter wraps
+    if (++m_generation == 0)
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_generation = 1;
+    }
+}
+
+bool DStarLite::isOpen(const SolidGridView& grid, int row, int col) const
+{
+    return inWindow(row, col) && grid.isOpen(row, col);
+}
+
+bool DStarLite::isAffectedBy(const std::vector<sf::Vector2i>& opened) const
+{
+    if (!m_active)
+        return false;
+
+    for (const sf::Vector2i& tile : opened)
+    {
+        if (!inWindow(tile.y, tile.x))
+            continue;
+
+        if (isTracked(toCell(tile.y, tile.x)))
+            return true;
+
+        // an untouched tile next to something the search reached still changes that cell's edges
+        for (int i = 0; i < 4; ++i)
+        {
+            int row = tile.y + ROW_STEP[i];
+            int col = tile.x + COL_STEP[i];
+
+            if (inWindow(row, col) && isTracked(toCell(row, col)))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+int DStarLite::heuristic(int cell) const
+{
+    return std::abs(cell % m_cols - m_start.x) + std::abs(rowOf(cell) - m_start.y);
+}
+
+DStarLite::QueueEntry DStarLite::calculateKey(int cell) const
+{
+    Cell values = getCell(cell);
+    int best = std::min(values.g, values.rhs);
+
+    if (best >= INF)
+        return { INF, INF, cell };
+
+    return { best + heuristic(cell) + m_keyModifier, best, cell };
+}
+
+void DStarLite::push(int cell)
+{
+    m_open.push_back(calculateKey(cell));
+    std::push_heap(m_open.begin(), m_open.end(), std::greater<QueueEntry>());
+}
+
+void DStarLite::updateVertex(const SolidGridView& grid, int cell)
+{
+    if (cell != m_goalCell)
+    {
+        int row = rowOf(cell);
+        int col = cell % m_cols;
+        int rhs = INF;
+
+        // moving into a tile costs one as long as it's open
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextRow = row + ROW_STEP[i];
+            int nextCol = col + COL_STEP[i];
+
+            if (!isOpen(grid, nextRow, nextCol))
+                continue;
+
+            int g = getCell(toCell(nextRow, nextCol)).g;
+
+            if (g < INF)
+                rhs = std::min(rhs, g + 1);
+        }
+
+        Cell current = getCell(cell);
+
+        if (current.g >= INF && rhs >= INF)
+        {
+            // still unreachable, no need to start tracking it
+            if (isTracked(cell))
+                m_rhs[cell] = INF;
+            return;
+        }
+
+        track(cell);
+        m_rhs[cell] = rhs;
+    }
+
+    Cell values = getCell(cell);
+
+    if (values.g != values.rhs)
+        push(cell);
+}
+
+void DStarLite::updatePredecessors(const SolidGridView& grid, int cell)
+{
+    int row = rowOf(cell);
+    int col = cell % m_cols;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int nextRow = row + ROW_STEP[i];
+        int nextCol = col + COL_STEP[i];
+
+        if (!inWindow(nextRow, nextCol))
+            continue;
+
+        int next = toCell(nextRow, nextCol);
+
+        // solid tiles never walk anywhere, except the start which may still be being dug
+        if (isOpen(grid, nextRow, nextCol) || next == m_startCell)
+            updateVertex(grid, next);
+    }
+}
+
+void DStarLite::computeShortestPath(const SolidGridView& grid)
+{
+    while (!m_open.empty())
+    {
+        QueueEntry top = m_open.front();
+        Cell values = getCell(top.cell);
+
+        // already consistent, this entry is left over from an earlier push
+        if (values.g == values.rhs)
+        {
+            std::pop_heap(m_open.begin(), m_open.end(), std::greater<QueueEntry>());
+            m_open.pop_back();
+            continue;
+        }
+
+        Cell start = getCell(m_startCell);
+        QueueEntry startKey = calculateKey(m_startCell);
+
+        if (!(startKey > top) && start.g == start.rhs)
+            break;
+
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<QueueEntry>());
+        m_open.pop_back();
+
+        QueueEntry current = calculateKey(top.cell);
+
+        if (current > top)
+        {
+            m_open.push_back(current);
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<QueueEntry>());
+            continue;
+        }
+
+        ++m_lastExpanded;
+
+        if (values.g > values.rhs)
+        {
+            m_g[top.cell] = values.rhs;
+            updatePredecessors(grid, top.cell);
+        }
+        else
+        {
+            m_g[top.cell] = INF;
+            updateVertex(grid, top.cell);
+            updatePredecessors(grid, top.cell);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef DSTAR_LITE_H
+#define DSTAR_LITE_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include "GridAStar.h"
+
+// rows searched above and below the start / goal, paths that need to detour further fail
+const int DSTAR_WINDOW_MARGIN = 16;
+
+// D* Lite towards one goal tile. The search runs backwards from the goal and keeps its
+// g / rhs values between calls, so when tiles open up only the cells whose distance
+// actually changes are expanded again instead of planning from scratch.
+// It only searches the band of rows around the start and goal (DSTAR_WINDOW_MARGIN either
+// side), g / rhs live in flat arrays over that band stamped like GridAStar's.
+class DStarLite
+{
+public:
+    bool plan(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal);
+    // start is wherever the walker is now, opened holds the tiles dug out since the last call
+    bool repair(const SolidGridView& grid, sf::Vector2i start, const std::vector<sf::Vector2i>& opened);
+    // steepest descent from the start, same layout as GridAStar paths
+    bool extractPath(const SolidGridView& grid, std::vector<sf::Vector2i>& path) const;
+
+    void clear();
+    bool isActive() const { return m_active; }
+    // false when none of opened is next to anything the search has looked at, so repair would be a no-op
+    bool isAffectedBy(const std::vector<sf::Vector2i>& opened) const;
+    sf::Vector2i getGoal() const { return m_goal; }
+
+    int getLastExpanded() const { return m_lastExpanded; }
+
+private:
+    struct Cell
+    {
+        int g;
+        int rhs;
+    };
+
+    struct QueueEntry
+    {
+        int primary;
+        int secondary;
+        int cell;
+
+        bool operator>(const QueueEntry& other) const
+        {
+            if (primary != other.primary)
+                return primary > other.primary;
+            return secondary > other.secondary;
+        }
+    };
+
+    static const int INF = 1 << 29;
+
+    Cell getCell(int cell) const;
+    bool isTracked(int cell) const { return m_stamp[cell] == m_generation; }
+    void track(int cell);
+    void prepare(int cellCount);
+    // grid.isOpen, but anything outside the window counts as solid
+    bool isOpen(const SolidGridView& grid, int row, int col) const;
+    bool inWindow(int row, int col) const { return row >= m_firstRow && row < m_firstRow + m_rows && col >= 0 && col < m_cols; }
+    int toCell(int row, int col) const { return (row - m_firstRow) * m_cols + col; }
+    int rowOf(int cell) const { return cell / m_cols + m_firstRow; }
+    QueueEntry calculateKey(int cell) const;
+    void push(int cell);
+    void updateVertex(const SolidGridView& grid, int cell);
+    void updatePredecessors(const SolidGridView& grid, int cell);
+    void computeShortestPath(const SolidGridView& grid);
+    int heuristic(int cell) const;
+
+    // indexed by toCell(), a cell the search hasn't touched this plan is g = rhs = INF
+    std::vector<int> m_g;
+    std::vector<int> m_rhs;
+    std::vector<std::uint32_t> m_stamp;
+    std::uint32_t m_generation = 0;
+    std::vector<QueueEntry> m_open;     // min heap, stale entries skipped when popped
+
+    int m_firstRow = 0;
+    int m_rows = 0;
+    int m_cols = 0;
+    int m_startCell = -1;
+    int m_goalCell = -1;
+    sf::Vector2i m_start;
+    sf::Vector2i m_lastStart;
+    sf::Vector2i m_goal;
+    int m_keyModifier = 0;      // km, grows as the start moves so old keys stay valid
+    bool m_active = false;
+
+    int m_lastExpanded = 0;
+};
+
+#endif // !DSTAR_LITE_H
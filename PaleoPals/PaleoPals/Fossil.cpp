@@ -1,115 +1,59 @@
 #include "Fossil.h"
+#include "TextureAtlas.h"
 #include <iostream>
 #include <fstream>
 #include <random>
 #include <algorithm>
-#include <json.hpp>
-
-using json = nlohmann::json;
+#include <cmath>
 
 FossilManager::FossilManager()
 {
 }
 
-bool FossilManager::loadFossilsFromConfig(const std::string& filepath)
+bool FossilManager::loadFossilsFromConfig(const std::vector<CollectibleType>& collectibleTypes, const std::vector<DinosaurData>& dinosaurs)
 {
-    std::ifstream file(filepath);
+    // already parsed and checked by GameConfig
+    m_collectibleTypes = collectibleTypes;
+    m_dinosaurData = dinosaurs;
 
-    if (!file.is_open())
-    {
-        std::cerr << "Failed to open JSON config for fossils: " << filepath << std::endl;
-        return false;
-    }
+    std::cout << "Loaded " << m_collectibleTypes.size() << " collectible types from config\n";
 
-    try
+    if (m_collectibleTypes.empty())
     {
-        json config;
-        file >> config;
-
-        if (config.contains("collectibles"))
-        {
-            auto collectibles = config["collectibles"];
-            for (auto& collectNode : collectibles)
-            {
-                CollectibleType collectType;
-                collectType.index = collectNode["index"].get<int>();
-                collectType.name = collectNode["name"].get<std::string>();
-                collectType.type = collectNode["type"].get<std::string>();
-                collectType.texture = collectNode["texture"].get<std::string>();
-                collectType.frameWidth = collectNode["frameWidth"].get<int>();
-                collectType.frameHeight = collectNode["frameHeight"].get<int>();
-                collectType.frameIndex = collectNode["frameIndex"].get<int>();
-                collectType.monetaryValue = collectNode["monetaryValue"].get<int>();
-                
-                m_collectibleTypes.push_back(collectType);
-            }
-            std::cout << "Loaded " << m_collectibleTypes.size() << " collectible types from config\n";
-        }
-
-        if (!config.contains("dinosaurs"))
-        {
-            std::cerr << "No dinosaurs section found in config\n";
-            return false;
-        }
-
-        auto dinosaurs = config["dinosaurs"];
-
-        for (auto& dinoNode : dinosaurs)
-        {
-            DinosaurData dino;
-
-            dino.name = dinoNode["name"].get<std::string>();
-            dino.category = dinoNode["category"].get<std::string>();
-            dino.backgroundTexture = dinoNode["background"].get<std::string>();
-            dino.skinTexture = dinoNode["skinTexture"].get<std::string>();
-            
-
-
-            for (auto& pieceNode : dinoNode["pieces"])
-            {
-                DinosaurData::Piece piece;
-                piece.id = pieceNode["id"].get<std::string>();          
-                piece.texturePath = pieceNode["texture"].get<std::string>(); 
-
-                dino.pieces.push_back(piece);
-            }
-
-            m_dinosaurData.push_back(std::move(dino));
-        }
-
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "Error loading JSON fossil config: " << e.what() << std::endl;
+        std::cerr << "No collectible types loaded, cannot load texture\n";
         return false;
     }
 
-    if (!m_collectibleTypes.empty())
-    {
-        const std::string& sheetPath = m_collectibleTypes[0].texture;
+    m_sheetPath = m_collectibleTypes[0].texture;
 
-        if (!m_collectibleTexture.loadFromFile(sheetPath))
-        {
-            std::cerr << "Failed to load collectibles sheet: " << sheetPath << "\n";
-            return false;
-        }
+    return true;
+}
 
-        m_textureLoaded = true;
-        std::cout << "Collectibles sheet loaded: " << sheetPath << "\n";
-    }
-    else
+bool FossilManager::addSheetToAtlas(TextureAtlas& atlas)
+{
+    if (!atlas.addImageFromFile("collectibles", m_sheetPath))
     {
-        std::cerr << "No collectible types loaded, cannot load texture\n";
+        std::cerr << "Failed to load collectibles sheet: " << m_sheetPath << "\n";
         return false;
     }
 
     return true;
 }
 
-void FossilManager::cacheGridOffsets(float offsetX, float offsetY)
+void FossilManager::useAtlas(const TextureAtlas& atlas)
+{
+    m_atlasTexture = &atlas.getTexture();
+    m_sheetOrigin = atlas.getRect("collectibles").position;
+    m_textureLoaded = true;
+
+    std::cout << "Collectibles sheet packed into atlas: " << m_sheetPath << "\n";
+}
+
+void FossilManager::cacheGridOffsets(float offsetX, float offsetY, float tileSize)
 {
     m_cachedOffsetX = offsetX;
     m_cachedOffsetY = offsetY;
+    m_tileSize = tileSize;
 }
 
 bool FossilManager::trySpawnCollectible(int row, int col, float tileSize, float windowWidth, float windowHeight)
@@ -132,7 +76,7 @@ bool FossilManager::trySpawnCollectible(int row, int col, float tileSize, float
 
     int collectibleIndex = pickRandomCollectibleIndex();
 
-    Collectible c(m_collectibleTexture, sf::Vector2f(xPos, yPos), collectibleIndex, row, col);
+    Collectible c(*m_atlasTexture, sf::Vector2f(xPos, yPos), collectibleIndex, row, col);
 
     c.sprite.setScale(sf::Vector2f(0.5f, 0.5f));
 
@@ -141,13 +85,13 @@ bool FossilManager::trySpawnCollectible(int row, int col, float tileSize, float
         const CollectibleType& cfg = m_collectibleTypes[collectibleIndex];
 
 		c.sprite.setOrigin(sf::Vector2f(cfg.frameWidth / 2.f, cfg.frameHeight / 2.f));
-        c.sprite.setTextureRect(sf::IntRect({ cfg.frameIndex * cfg.frameWidth, 0 }, { cfg.frameWidth, cfg.frameHeight }));
+        c.sprite.setTextureRect(sf::IntRect(m_sheetOrigin + sf::Vector2i(cfg.frameIndex * cfg.frameWidth, 0), { cfg.frameWidth, cfg.frameHeight }));
 
         c.monetaryValue = cfg.monetaryValue;
     }
     else
     {
-        c.sprite.setTextureRect(sf::IntRect({ collectibleIndex * 64, 0 }, { 64, 64 }));
+        c.sprite.setTextureRect(sf::IntRect(m_sheetOrigin + sf::Vector2i(collectibleIndex * 64, 0), { 64, 64 }));
 		c.sprite.setOrigin(sf::Vector2f(32.f, 32.f));
     }
 
@@ -159,47 +103,323 @@ bool FossilManager::trySpawnCollectible(int row, int col, float tileSize, float
 
     std::cout << "[Drop] " << typeName << " (idx=" << collectibleIndex << ") at tile (" << row << "," << col << ")\n";
 
-    m_collectibles.push_back(std::move(c));
+    // reuse a freed slot before growing
+    std::uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    m_slots[slot].item.emplace(std::move(c));
+    m_slots[slot].aliveIndex = static_cast<int>(m_alive.size());
+    m_alive.push_back(slot);
+
+    addToCell(slot);
     return true;
 }
 
-void FossilManager::drawCollectibles(sf::RenderWindow& window)
+void FossilManager::drawCollectibles(sf::RenderWindow& window, const TileRange& visibleTiles)
 {
-    sf::View view = window.getView();
-    sf::Vector2f vc = view.getCenter();
-    sf::Vector2f vs = view.getSize();
-    const float pad = 100.f;
+    if (visibleTiles.isEmpty())
+        return;
 
-    sf::FloatRect viewBounds(
-        sf::Vector2f(vc.x - vs.x / 2.f - pad, vc.y - vs.y / 2.f - pad),
-        sf::Vector2f(vs.x + pad * 2.f, vs.y + pad * 2.f));
+    int firstCellRow = std::max(visibleTiles.firstRow / COLLECTIBLE_CELL_TILES, m_minCellRow);
+    int lastCellRow = std::min((visibleTiles.lastRow - 1) / COLLECTIBLE_CELL_TILES, m_maxCellRow);
+    int firstCellCol = std::max(visibleTiles.firstCol / COLLECTIBLE_CELL_TILES, m_minCellCol);
+    int lastCellCol = std::min((visibleTiles.lastCol - 1) / COLLECTIBLE_CELL_TILES, m_maxCellCol);
 
-    for (auto& c : m_collectibles)
+    for (int cellRow = firstCellRow; cellRow <= lastCellRow; ++cellRow)
     {
-        if (c.isPickedUp) continue;
+        for (int cellCol = firstCellCol; cellCol <= lastCellCol; ++cellCol)
+        {
+            auto it = m_cells.find(cellKey(cellRow, cellCol));
+            if (it == m_cells.end())
+                continue;
 
-        if (!viewBounds.findIntersection(c.sprite.getGlobalBounds()))
-            continue;
+            for (std::uint32_t slot : it->second)
+            {
+                Collectible& c = *m_slots[slot].item;
+
+                if (!visibleTiles.contains(c.gridRow, c.gridCol))
+                    continue;
 
-        c.sprite.setColor(sf::Color::White);
-        window.draw(c.sprite);
+                c.sprite.setColor(sf::Color::White);
+                window.draw(c.sprite);
+            }
+        }
     }
 }
 
 Collectible* FossilManager::getCollectibleNearTile(int playerRow, int playerCol, int range)
 {
-    for (auto& c : m_collectibles)
+    int firstCellRow = (playerRow - range) / COLLECTIBLE_CELL_TILES;
+    int lastCellRow = (playerRow + range) / COLLECTIBLE_CELL_TILES;
+    int firstCellCol = (playerCol - range) / COLLECTIBLE_CELL_TILES;
+    int lastCellCol = (playerCol + range) / COLLECTIBLE_CELL_TILES;
+
+    for (int cellRow = firstCellRow; cellRow <= lastCellRow; ++cellRow)
     {
-        if (c.isPickedUp) continue;
-        if (std::abs(c.gridRow - playerRow) <= range &&
-            std::abs(c.gridCol - playerCol) <= range)
+        for (int cellCol = firstCellCol; cellCol <= lastCellCol; ++cellCol)
         {
-            return &c;
+            auto it = m_cells.find(cellKey(cellRow, cellCol));
+            if (it == m_cells.end())
+                continue;
+
+            for (std::uint32_t slot : it->second)
+            {
+                Collectible& c = *m_slots[slot].item;
+
+                if (std::abs(c.gridRow - playerRow) <= range &&
+                    std::abs(c.gridCol - playerCol) <= range)
+                {
+                    return &c;
+                }
+            }
         }
     }
     return nullptr;
 }
 
+CollectibleHandle FossilManager::findNearest(sf::Vector2f worldPos, float maxRadius, const std::function<bool(const Collectible&)>& accept) const
+{
+    if (m_alive.empty())
+        return CollectibleHandle();
+
+    sf::Vector2i centre = worldToCell(worldPos);
+    float cellSize = COLLECTIBLE_CELL_TILES * m_tileSize;
+
+    // no point searching rings past the furthest bucket that has ever held something
+    int maxRing = std::max({ centre.y - m_minCellRow, m_maxCellRow - centre.y, centre.x - m_minCellCol, m_maxCellCol - centre.x });
+    maxRing = std::min(maxRing, static_cast<int>(maxRadius / cellSize) + 1);
+
+    std::uint32_t bestSlot = CollectibleHandle::INVALID_INDEX;
+    float bestDistSq = maxRadius * maxRadius;
+
+    auto searchCell = [&](int cellRow, int cellCol)
+        {
+            auto it = m_cells.find(cellKey(cellRow, cellCol));
+            if (it == m_cells.end())
+                return;
+
+            for (std::uint32_t slot : it->second)
+            {
+                if (accept && !accept(*m_slots[slot].item))
+                    continue;
+
+                sf::Vector2f diff = m_slots[slot].item->sprite.getPosition() - worldPos;
+                float distSq = diff.x * diff.x + diff.y * diff.y;
+
+                if (distSq <= bestDistSq)
+                {
+                    bestDistSq = distSq;
+                    bestSlot = slot;
+                }
+            }
+        };
+
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        // anything in this ring is at least (ring - 1) cells away, stop once that can't beat the best
+        float ringDist = (ring - 1) * cellSize;
+        if (bestSlot != CollectibleHandle::INVALID_INDEX && ring > 0 && ringDist * ringDist > bestDistSq)
+            break;
+
+        // only the ring's four edges, clamped to the buckets that can hold anything
+        int top = centre.y - ring;
+        int bottom = centre.y + ring;
+        int left = centre.x - ring;
+        int right = centre.x + ring;
+
+        int firstCol = std::max(left, m_minCellCol);
+        int lastCol = std::min(right, m_maxCellCol);
+        int firstRow = std::max(top + 1, m_minCellRow);
+        int lastRow = std::min(bottom - 1, m_maxCellRow);
+
+        if (top >= m_minCellRow && top <= m_maxCellRow)
+        {
+            for (int cellCol = firstCol; cellCol <= lastCol; ++cellCol)
+                searchCell(top, cellCol);
+        }
+
+        if (ring > 0 && bottom >= m_minCellRow && bottom <= m_maxCellRow)
+        {
+            for (int cellCol = firstCol; cellCol <= lastCol; ++cellCol)
+                searchCell(bottom, cellCol);
+        }
+
+        if (left >= m_minCellCol && left <= m_maxCellCol)
+        {
+            for (int cellRow = firstRow; cellRow <= lastRow; ++cellRow)
+                searchCell(cellRow, left);
+        }
+
+        if (ring > 0 && right >= m_minCellCol && right <= m_maxCellCol)
+        {
+            for (int cellRow = firstRow; cellRow <= lastRow; ++cellRow)
+                searchCell(cellRow, right);
+        }
+    }
+
+    if (bestSlot == CollectibleHandle::INVALID_INDEX)
+        return CollectibleHandle();
+
+    return CollectibleHandle{ bestSlot, m_slots[bestSlot].generation };
+}
+
+void FossilManager::queryRadius(sf::Vector2f worldPos, float radius, std::vector<CollectibleHandle>& results) const
+{
+    results.clear();
+
+    sf::Vector2i first = worldToCell(worldPos - sf::Vector2f(radius, radius));
+    sf::Vector2i last = worldToCell(worldPos + sf::Vector2f(radius, radius));
+    float radiusSq = radius * radius;
+
+    for (int cellRow = first.y; cellRow <= last.y; ++cellRow)
+    {
+        for (int cellCol = first.x; cellCol <= last.x; ++cellCol)
+        {
+            auto it = m_cells.find(cellKey(cellRow, cellCol));
+            if (it == m_cells.end())
+                continue;
+
+            for (std::uint32_t slot : it->second)
+            {
+                sf::Vector2f diff = m_slots[slot].item->sprite.getPosition() - worldPos;
+
+                if (diff.x * diff.x + diff.y * diff.y <= radiusSq)
+                {
+                    results.push_back(CollectibleHandle{ slot, m_slots[slot].generation });
+                }
+            }
+        }
+    }
+}
+
+Collectible* FossilManager::get(CollectibleHandle handle)
+{
+    if (handle.index >= m_slots.size())
+        return nullptr;
+
+    CollectibleSlot& slot = m_slots[handle.index];
+
+    if (slot.generation != handle.generation || !slot.item)
+        return nullptr;
+
+    return &*slot.item;
+}
+
+CollectibleHandle FossilManager::getHandle(int row, int col) const
+{
+    auto it = m_cells.find(cellKey(row / COLLECTIBLE_CELL_TILES, col / COLLECTIBLE_CELL_TILES));
+
+    if (it == m_cells.end())
+        return CollectibleHandle();
+
+    for (std::uint32_t slot : it->second)
+    {
+        const Collectible& c = *m_slots[slot].item;
+
+        if (c.gridRow == row && c.gridCol == col)
+        {
+            return CollectibleHandle{ slot, m_slots[slot].generation };
+        }
+    }
+
+    return CollectibleHandle();
+}
+
+void FossilManager::removeCollectible(CollectibleHandle handle)
+{
+    if (!get(handle))
+        return;
+
+    std::uint32_t slotIndex = handle.index;
+    CollectibleSlot& slot = m_slots[slotIndex];
+
+    removeFromCell(slotIndex);
+
+    // keep the alive list packed by moving its last entry into the gap
+    std::uint32_t movedSlot = m_alive.back();
+    m_alive[slot.aliveIndex] = movedSlot;
+    m_slots[movedSlot].aliveIndex = slot.aliveIndex;
+    m_alive.pop_back();
+
+    slot.item.reset();
+    slot.aliveIndex = -1;
+    ++slot.generation;
+    m_freeSlots.push_back(slotIndex);
+}
+
+std::int64_t FossilManager::cellKey(int cellRow, int cellCol)
+{
+    return (static_cast<std::int64_t>(cellRow) << 32) | static_cast<std::uint32_t>(cellCol);
+}
+
+sf::Vector2i FossilManager::worldToCell(sf::Vector2f worldPos) const
+{
+    int col = static_cast<int>(std::floor((worldPos.x - m_cachedOffsetX) / m_tileSize));
+    int row = static_cast<int>(std::floor((worldPos.y - m_cachedOffsetY) / m_tileSize));
+
+    // floor division so tiles left of or above the grid still land in the right bucket
+    auto toCell = [](int tile)
+        {
+            return (tile >= 0) ? tile / COLLECTIBLE_CELL_TILES : -((-tile + COLLECTIBLE_CELL_TILES - 1) / COLLECTIBLE_CELL_TILES);
+        };
+
+    return sf::Vector2i(toCell(col), toCell(row));
+}
+
+void FossilManager::addToCell(std::uint32_t slot)
+{
+    const Collectible& c = *m_slots[slot].item;
+    int cellRow = c.gridRow / COLLECTIBLE_CELL_TILES;
+    int cellCol = c.gridCol / COLLECTIBLE_CELL_TILES;
+
+    m_cells[cellKey(cellRow, cellCol)].push_back(slot);
+
+    if (m_maxCellRow < m_minCellRow)
+    {
+        m_minCellRow = m_maxCellRow = cellRow;
+        m_minCellCol = m_maxCellCol = cellCol;
+    }
+    else
+    {
+        m_minCellRow = std::min(m_minCellRow, cellRow);
+        m_maxCellRow = std::max(m_maxCellRow, cellRow);
+        m_minCellCol = std::min(m_minCellCol, cellCol);
+        m_maxCellCol = std::max(m_maxCellCol, cellCol);
+    }
+}
+
+void FossilManager::removeFromCell(std::uint32_t slot)
+{
+    const Collectible& c = *m_slots[slot].item;
+    auto it = m_cells.find(cellKey(c.gridRow / COLLECTIBLE_CELL_TILES, c.gridCol / COLLECTIBLE_CELL_TILES));
+
+    if (it == m_cells.end())
+        return;
+
+    std::vector<std::uint32_t>& bucket = it->second;
+    auto pos = std::find(bucket.begin(), bucket.end(), slot);
+
+    if (pos != bucket.end())
+    {
+        *pos = bucket.back();
+        bucket.pop_back();
+    }
+
+    if (bucket.empty())
+    {
+        m_cells.erase(it);
+    }
+}
+
 void FossilManager::assignRandomFossilToPiece(Collectible& collectible)
 {
     if (m_dinosaurData.empty())
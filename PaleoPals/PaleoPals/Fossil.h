@@ -6,6 +6,16 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include "constants.h"
+
+class TextureAtlas;
+
+// collectibles are bucketed by blocks of this many tiles on each side
+const int COLLECTIBLE_CELL_TILES = 4;
 
 // Represents a single collectible type configuration
 struct CollectibleType
@@ -44,7 +54,6 @@ public:
     int collectibleIndex = 0;           // 0-11
     int gridRow = -1;
     int gridCol = -1;
-    bool isPickedUp = false;
 
     std::string assignedDinosaurName;
     std::string assignedPieceId;
@@ -65,31 +74,58 @@ public:
 
 using FossilPiece = Collectible;
 
+// stable reference to a collectible slot, goes stale once that collectible is removed even if the slot is reused
+struct CollectibleHandle
+{
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    bool operator==(const CollectibleHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const CollectibleHandle& other) const { return !(*this == other); }
+};
+
 class FossilManager
 {
 public:
     FossilManager();
      
-    bool loadFossilsFromConfig(const std::string& filepath);
+    bool loadFossilsFromConfig(const std::vector<CollectibleType>& collectibleTypes, const std::vector<DinosaurData>& dinosaurs);
+
+    // the sheet is packed into the shared atlas, sprites are only made once useAtlas has run
+    bool addSheetToAtlas(TextureAtlas& atlas);
+    void useAtlas(const TextureAtlas& atlas);
 
-    void cacheGridOffsets(float offsetX, float offsetY);
+    void cacheGridOffsets(float offsetX, float offsetY, float tileSize);
 
 
     bool trySpawnCollectible(int row, int col, float tileSize, float windowWidth, float windowHeight);
 
-    void drawCollectibles(sf::RenderWindow& window);
+    // only collectibles whose tile lies inside visibleTiles are drawn
+    void drawCollectibles(sf::RenderWindow& window, const TileRange& visibleTiles);
 
 
     Collectible* getCollectibleNearTile(int playerRow, int playerCol, int range = 1);
 
-    // Direct access to every collectible (for Player::tryPickupCollectible)
-    std::vector<Collectible>& getAllCollectibles() { return m_collectibles; }
+    // spatial queries, only the buckets around worldPos are looked at
+    // accept can skip collectibles the caller has no use for, e.g. ones it can't reach
+    CollectibleHandle findNearest(sf::Vector2f worldPos, float maxRadius = 1.0e9f, const std::function<bool(const Collectible&)>& accept = nullptr) const;
+    void queryRadius(sf::Vector2f worldPos, float radius, std::vector<CollectibleHandle>& results) const;
+
+    // nullptr once the collectible behind the handle has been removed
+    Collectible* get(CollectibleHandle handle);
+    CollectibleHandle getHandle(int row, int col) const;
+
+    // frees the slot for the next drop, every handle to it goes stale
+    void removeCollectible(CollectibleHandle handle);
 
     const std::vector<DinosaurData>& getDinosaurData() const { return m_dinosaurData; }
 
     FossilPiece* getFossilAtTile(int row, int col) { return getCollectibleNearTile(row, col, 0); }
 
-    int getTotalCollectibleCount() const { return static_cast<int>(m_collectibles.size()); }
+    int getTotalCollectibleCount() const { return static_cast<int>(m_alive.size()); }
 
     // Tune drop rate (0-100).  Default = 40 (40% chance per broken tile).
     void setSpawnChance(int percent) { m_spawnChancePercent = percent; }
@@ -98,14 +134,34 @@ public:
 
 private:
     std::vector<DinosaurData> m_dinosaurData;
-    sf::Texture m_collectibleTexture;
-    std::vector<Collectible>  m_collectibles;
+    std::string m_sheetPath;
+    const sf::Texture* m_atlasTexture = nullptr;
+    sf::Vector2i m_sheetOrigin;          // top left of the collectibles sheet inside the atlas
+    // collectibles live in reusable slots, a slot's generation goes up every time it is freed
+    struct CollectibleSlot
+    {
+        std::optional<Collectible> item;
+        std::uint32_t generation = 0;
+        int aliveIndex = -1;             // position in m_alive while occupied
+    };
+
+    std::vector<CollectibleSlot> m_slots;
+    std::vector<std::uint32_t> m_freeSlots;
+    std::vector<std::uint32_t> m_alive;  // occupied slots, packed for iteration
+
+    // uniform grid over tile space, each bucket holds slot indices
+    std::unordered_map<std::int64_t, std::vector<std::uint32_t>> m_cells;
+    int m_minCellRow = 0;
+    int m_maxCellRow = -1;
+    int m_minCellCol = 0;
+    int m_maxCellCol = -1;
     std::vector<CollectibleType> m_collectibleTypes;  // Store config data for each collectible type
 
     bool m_textureLoaded = false;
 
     float m_cachedOffsetX = 0.f;
     float m_cachedOffsetY = 0.f;
+    float m_tileSize = 1.f;
 
     int m_spawnChancePercent = 45;
 
@@ -114,6 +170,11 @@ private:
 
     int  pickRandomCollectibleIndex();
 
+    static std::int64_t cellKey(int cellRow, int cellCol);
+    sf::Vector2i worldToCell(sf::Vector2f worldPos) const;   // x = cell col, y = cell row
+    void addToCell(std::uint32_t slot);
+    void removeFromCell(std::uint32_t slot);
+
 };
 
 #endif // FOSSIL_H
\ No newline at end of file
@@ -2,9 +2,11 @@
 
 #include "Game.h"
 #include "Map.h"
+#include "AssetCache.h"
 #include <iostream>
 
 Game::Game() :
+    m_uiFont{ AssetCache::get().getFont("ASSETS/FONTS/Jersey20-Regular.ttf") },
     m_window{ sf::VideoMode{sf::Vector2u{WINDOW_X, WINDOW_Y},32 }, "PaleoPals" },
     m_DELETEexitGame{ false }
 {
@@ -17,18 +19,16 @@ Game::Game() :
     m_menu.initMenu();
     m_pause.initPauseMenu();
 
-    m_uiFont.openFromFile("ASSETS/FONTS/Jersey20-Regular.ttf");
-
-    m_moneyText.setFont(m_uiFont);
+    m_moneyText.setFont(*m_uiFont);
     m_moneyText.setCharacterSize(28);
     m_moneyText.setFillColor(sf::Color::Yellow);
 
-    m_traderTutText.setFont(m_uiFont);
+    m_traderTutText.setFont(*m_uiFont);
     m_traderTutText.setCharacterSize(28);
     m_traderTutText.setFillColor(sf::Color::Yellow);
     m_traderTutText.setPosition(sf::Vector2f(WINDOW_X / 2.0f - 400, 0.0f));
 
-    m_museumTutText.setFont(m_uiFont);
+    m_museumTutText.setFont(*m_uiFont);
     m_museumTutText.setCharacterSize(28);
     m_museumTutText.setFillColor(sf::Color::Yellow);
     m_museumTutText.setPosition(sf::Vector2f(WINDOW_X / 2.0f, 0.0f));
@@ -108,7 +108,14 @@ void Game::processEvents()
 
                         if (action == HireAction::HirePaleontologist)
                         {
-                           
+                            int cost = m_traderMenu.getHirePaleontologistCost();
+
+                            if (m_player.getMoney() >= cost)
+                            {
+                                m_player.spendMoney(cost);
+                                m_workers.hire(m_player.getPosition(), m_map);
+                                m_traderMenu.paleontologistsHired++;
+                            }
                         }
                         else if (action == HireAction::HireResearcher)
                         {
@@ -210,6 +217,26 @@ void Game::processKeys(const std::optional<sf::Event> t_event)
         if (m_currentState == GameState::Gameplay && newKeypress->code == sf::Keyboard::Key::F3)
         {
             m_map.toggleDebugMode();
+            AssetCache::get().printStats();
+            m_workers.printPathStats();
+        }
+
+        // F5 drops a few hundred extra diggers in to check the worker update holds up
+        if (m_currentState == GameState::Gameplay && newKeypress->code == sf::Keyboard::Key::F5)
+        {
+            m_workers.toggleStressTest(m_map);
+        }
+
+        // F7 moves path searches between time slicing on the main thread and a worker thread
+        if (m_currentState == GameState::Gameplay && newKeypress->code == sf::Keyboard::Key::F7)
+        {
+            m_workers.getPathService().setThreaded(!m_workers.getPathService().isThreaded());
+        }
+
+        // F8 swaps workers between the coroutine task scripts and the data driven behaviour tree
+        if (m_currentState == GameState::Gameplay && newKeypress->code == sf::Keyboard::Key::F8)
+        {
+            m_workers.setUseTasks(!m_workers.isUsingTasks(), m_map);
         }
 
         if (newKeypress->code == sf::Keyboard::Key::T)
@@ -258,12 +285,18 @@ void Game::update(sf::Time t_deltaTime)
     switch (m_currentState)
     {
     case GameState::MainMenu:
+        // a few ms of texture uploads per frame so the menu stays responsive
+        m_assetLoader.uploadPending(sf::milliseconds(4));
+        m_menu.setLoadingProgress(m_assetLoader.getProgress());
         m_menu.update(m_window);
         break;
 
     case GameState::Gameplay:
         moveCamera(t_deltaTime);
 
+        // museum species stream in as they are viewed
+        m_assetLoader.uploadPending(sf::milliseconds(2));
+
         m_map.handleMouseHold(m_window, 24, 75);
         m_map.updateHover(m_window, 24.0f, 75);
         m_map.updateMuseum(m_window);
@@ -280,8 +313,15 @@ void Game::update(sf::Time t_deltaTime)
         else
         {
 
+            // generate terrain ahead of whoever has dug deepest
+            int deepestRow = std::max(m_map.worldToTile(m_player.getPosition()).y, m_workers.getDeepestRow(m_map));
+            m_map.updateStreaming(deepestRow);
+
             m_player.update(t_deltaTime, m_map, m_window, m_cameraView);
-            m_npc.updateNPC(t_deltaTime, m_map);
+            m_workers.update(t_deltaTime, m_map);
+
+            // all digging from this tick lands in one pass
+            m_map.resolveDamage();
 
 			sf::Vector2f playerPos = m_player.getPosition();
 
@@ -363,7 +403,7 @@ void Game::render()
 
 
             m_player.draw(m_window);
-            m_npc.drawNPC(m_window);
+            m_workers.draw(m_window, viewBounds);
         }
 
 		m_window.setView(m_window.getDefaultView());
@@ -402,33 +442,19 @@ void Game::setupMap()
     }
 
     int cols = 75;
-    int totalRows = 215;
+    int totalRows = 2000;
+    int initialRows = 64;
 
     float tileSize = 24.0f; 
 
     m_map.setupBackground();
-    m_map.generateGrid(totalRows, cols, tileSize, WINDOW_X, WINDOW_Y);
-	m_museumInterior.loadAssets(m_map.getFossilManager().getDinosaurData());
+    m_map.startStreaming(totalRows, initialRows, cols, tileSize, WINDOW_X, WINDOW_Y);
+	m_museumInterior.loadAssets(m_map.getFossilManager().getDinosaurData(), m_assetLoader);
    
     m_player.setPosition(sf::Vector2f(WINDOW_X / 2.0f + 100.0f, WINDOW_Y / 2.0f));
 
-
-
-    // Building Behaviour tree
-
-    auto miningSequence = new SequenceNode();
-
-    miningSequence->addChildNode(new BTWanderSurfaceNode(m_npc, m_map));
-    miningSequence->addChildNode(new BTMiningNode(m_npc, m_map));
-    miningSequence->addChildNode(new BTReturnToSurfaceNode(m_npc, m_map));
-	miningSequence->addChildNode(new BTCollectFossilNode(m_npc, m_map));
-	miningSequence->addChildNode(new BTReturnToSurfaceNode(m_npc, m_map));
-
-    auto rootSelector = new SelectorNode();
-
-    rootSelector->addChildNode(miningSequence);
-
-    m_npc.setRoot(rootSelector);
+    // one paleontologist comes with the dig site, the rest are hired from the trader
+    m_workers.hire(sf::Vector2f(WINDOW_X / 2.0f - 150.0f, WINDOW_Y / 2.0f - 40.0f), m_map);
 }
 
 void Game::moveCamera(sf::Time t_deltaTime)
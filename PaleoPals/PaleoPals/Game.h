@@ -15,7 +15,7 @@
 #include "TraderMenu.h"
 #include "MuseumInterior.h"
 #include "Player.h"
-#include "NPC.h"
+#include "WorkerManager.h"
 #include <vector>
 #include <memory>
 
@@ -43,18 +43,19 @@ private:
     bool upgradePickaxeRadius = false;
     bool upgradeDamage = false;
 
-    sf::Font m_uiFont;
-    sf::Text m_traderTutText{ m_uiFont };
-    sf::Text m_museumTutText{ m_uiFont };
-    sf::Text m_moneyText{ m_uiFont };
+    std::shared_ptr<sf::Font> m_uiFont;
+    sf::Text m_traderTutText{ *m_uiFont };
+    sf::Text m_museumTutText{ *m_uiFont };
+    sf::Text m_moneyText{ *m_uiFont };
 
     Map m_map;
     Menu m_menu;
     PauseMenu m_pause;
     Museum m_museum;
+    AssetLoader m_assetLoader;      // museum textures decode in the background while the menu is up
 	MuseumInterior m_museumInterior;
     Player m_player;
-    NPC m_npc;
+    WorkerManager m_workers;
 
     sf::RenderWindow m_window; // main SFML window
     sf::View m_cameraView;
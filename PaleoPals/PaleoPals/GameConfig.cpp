@@ -0,0 +1,431 @@
+#include "GameConfig.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <cstring>
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+    // flat little-endian blob, every value is written as its raw bytes
+    class BinaryWriter
+    {
+    public:
+        template <typename T>
+        void write(T value)
+        {
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        void writeString(const std::string& text)
+        {
+            write(static_cast<std::uint32_t>(text.size()));
+            m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+        }
+
+        const std::vector<char>& getBuffer() const { return m_buffer; }
+
+    private:
+        std::vector<char> m_buffer;
+    };
+
+    // reads back what BinaryWriter wrote, every read fails once the data runs out
+    class BinaryReader
+    {
+    public:
+        explicit BinaryReader(const std::vector<char>& buffer) : m_buffer(buffer) {}
+
+        template <typename T>
+        bool read(T& value)
+        {
+            if (m_offset + sizeof(T) > m_buffer.size())
+                return false;
+
+            std::memcpy(&value, m_buffer.data() + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        bool readString(std::string& text)
+        {
+            std::uint32_t length = 0;
+            if (!read(length) || m_offset + length > m_buffer.size())
+                return false;
+
+            text.assign(m_buffer.data() + m_offset, length);
+            m_offset += length;
+            return true;
+        }
+
+        // element count, rejected if there aren't even that many bytes left so a bad cache can't ask for a huge resize
+        bool readCount(std::uint32_t& count)
+        {
+            return read(count) && count <= m_buffer.size() - m_offset;
+        }
+
+        bool atEnd() const { return m_offset == m_buffer.size(); }
+
+    private:
+        const std::vector<char>& m_buffer;
+        size_t m_offset = 0;
+    };
+
+    void writeBuilding(BinaryWriter& out, const BuildingConfig& building)
+    {
+        out.writeString(building.texture);
+        out.write(building.frameWidth);
+        out.write(building.frameHeight);
+        out.write(building.position.x);
+        out.write(building.position.y);
+    }
+
+    bool readBuilding(BinaryReader& in, BuildingConfig& building)
+    {
+        return in.readString(building.texture)
+            && in.read(building.frameWidth)
+            && in.read(building.frameHeight)
+            && in.read(building.position.x)
+            && in.read(building.position.y);
+    }
+
+    BuildingConfig parseBuilding(const json& node)
+    {
+        BuildingConfig building;
+        building.texture = node["texture"].get<std::string>();
+        building.frameWidth = node["frameWidth"].get<int>();
+        building.frameHeight = node["frameHeight"].get<int>();
+        building.position = sf::Vector2f(node["position"]["x"].get<float>(), node["position"]["y"].get<float>());
+        return building;
+    }
+}
+
+bool GameConfig::loadFromFile(const std::string& jsonPath)
+{
+    std::error_code error;
+    std::uint64_t sourceSize = std::filesystem::file_size(jsonPath, error);
+
+    if (error)
+    {
+        std::cerr << "Failed to open JSON config: " << jsonPath << "\n";
+        return false;
+    }
+
+    std::int64_t sourceTime = static_cast<std::int64_t>(std::filesystem::last_write_time(jsonPath, error).time_since_epoch().count());
+
+    std::string cachePath = jsonPath + ".bin";
+
+    // the cache is only trusted while it was made from a JSON of the same size and timestamp
+    if (readCache(cachePath, sourceSize, sourceTime) && validate())
+    {
+        std::cout << "Loaded config from cache: " << cachePath << "\n";
+        return true;
+    }
+
+    *this = GameConfig();
+
+    if (!parseJson(jsonPath) || !validate())
+    {
+        return false;
+    }
+
+    writeCache(cachePath, sourceSize, sourceTime);
+
+    return true;
+}
+
+bool GameConfig::parseJson(const std::string& jsonPath)
+{
+    std::ifstream file(jsonPath);
+
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open JSON config: " << jsonPath << "\n";
+        return false;
+    }
+
+    try
+    {
+        json config;
+        file >> config;
+
+        // --- Terrain layers + crack frames ---
+        const json& mapNode = config.at("map");
+
+        for (auto& layerNode : mapNode.at("layers"))
+        {
+            LayerType layer;
+            layer.name = layerNode["name"].get<std::string>();
+            layer.texturePath = layerNode["texture"].get<std::string>();
+            layer.hardness = layerNode["hardness"].get<int>();
+            map.layers.push_back(std::move(layer));
+        }
+
+        if (mapNode.contains("cracks"))
+        {
+            const json& cracks = mapNode.at("cracks");
+            map.cracks.texture = cracks["texture"].get<std::string>();
+            map.cracks.frameWidth = cracks["frameWidth"].get<int>();
+            map.cracks.frameHeight = cracks["frameHeight"].get<int>();
+            map.cracks.frames = cracks["frames"].get<int>();
+        }
+
+        if (mapNode.contains("seed"))
+        {
+            map.hasSeed = true;
+            map.seed = mapNode.at("seed").get<std::uint64_t>();
+        }
+
+        // --- Buildings ---
+        if (config.contains("museum"))
+        {
+            hasMuseum = true;
+            museum = parseBuilding(config["museum"]);
+        }
+        if (config.contains("trader"))
+        {
+            hasTrader = true;
+            trader = parseBuilding(config["trader"]);
+        }
+
+        // --- Collectible + dinosaur config ---
+        if (config.contains("collectibles"))
+        {
+            for (auto& collectNode : config["collectibles"])
+            {
+                CollectibleType collectType;
+                collectType.index = collectNode["index"].get<int>();
+                collectType.name = collectNode["name"].get<std::string>();
+                collectType.type = collectNode["type"].get<std::string>();
+                collectType.texture = collectNode["texture"].get<std::string>();
+                collectType.frameWidth = collectNode["frameWidth"].get<int>();
+                collectType.frameHeight = collectNode["frameHeight"].get<int>();
+                collectType.frameIndex = collectNode["frameIndex"].get<int>();
+                collectType.monetaryValue = collectNode["monetaryValue"].get<int>();
+
+                collectibles.push_back(std::move(collectType));
+            }
+        }
+
+        if (config.contains("dinosaurs"))
+        {
+            for (auto& dinoNode : config["dinosaurs"])
+            {
+                DinosaurData dino;
+                dino.name = dinoNode["name"].get<std::string>();
+                dino.category = dinoNode["category"].get<std::string>();
+                dino.backgroundTexture = dinoNode["background"].get<std::string>();
+                dino.skinTexture = dinoNode["skinTexture"].get<std::string>();
+
+                for (auto& pieceNode : dinoNode["pieces"])
+                {
+                    DinosaurData::Piece piece;
+                    piece.id = pieceNode["id"].get<std::string>();
+                    piece.texturePath = pieceNode["texture"].get<std::string>();
+                    dino.pieces.push_back(std::move(piece));
+                }
+
+                dinosaurs.push_back(std::move(dino));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error loading JSON config: " << e.what() << "\n";
+        return false;
+    }
+
+    std::cout << "Parsed config: " << jsonPath << "\n";
+    return true;
+}
+
+bool GameConfig::validate() const
+{
+    // layer ids are stored in a byte with 0xFF meaning dug out
+    if (map.layers.empty() || map.layers.size() >= 0xFF)
+    {
+        std::cerr << "Map config needs between 1 and 254 layers\n";
+        return false;
+    }
+
+    if (map.cracks.frames <= 0 || map.cracks.frameWidth <= 0 || map.cracks.frameHeight <= 0)
+    {
+        std::cerr << "Map config has an empty crack strip\n";
+        return false;
+    }
+
+    if (collectibles.empty())
+    {
+        std::cerr << "No collectible types in config\n";
+        return false;
+    }
+
+    if (dinosaurs.empty())
+    {
+        std::cerr << "No dinosaurs section found in config\n";
+        return false;
+    }
+
+    for (const DinosaurData& dino : dinosaurs)
+    {
+        if (dino.pieces.empty())
+        {
+            std::cerr << "Dinosaur has no pieces: " << dino.name << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GameConfig::readCache(const std::string& cachePath, std::uint64_t sourceSize, std::int64_t sourceTime)
+{
+    std::ifstream file(cachePath, std::ios::binary);
+
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    BinaryReader in(buffer);
+
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint64_t cachedSize = 0;
+    std::int64_t cachedTime = 0;
+
+    if (!in.read(magic) || !in.read(version) || !in.read(cachedSize) || !in.read(cachedTime))
+        return false;
+
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || cachedSize != sourceSize || cachedTime != sourceTime)
+        return false;
+
+    std::uint32_t count = 0;
+
+    if (!in.readCount(count))
+        return false;
+
+    map.layers.resize(count);
+    for (LayerType& layer : map.layers)
+    {
+        if (!in.readString(layer.name) || !in.readString(layer.texturePath) || !in.read(layer.hardness))
+            return false;
+    }
+
+    if (!in.readString(map.cracks.texture) || !in.read(map.cracks.frameWidth) || !in.read(map.cracks.frameHeight) || !in.read(map.cracks.frames))
+        return false;
+
+    if (!in.read(map.hasSeed) || !in.read(map.seed))
+        return false;
+
+    if (!in.read(hasMuseum) || !readBuilding(in, museum) || !in.read(hasTrader) || !readBuilding(in, trader))
+        return false;
+
+    if (!in.readCount(count))
+        return false;
+
+    collectibles.resize(count);
+    for (CollectibleType& type : collectibles)
+    {
+        if (!in.read(type.index) || !in.readString(type.name) || !in.readString(type.type) || !in.readString(type.texture)
+            || !in.read(type.frameWidth) || !in.read(type.frameHeight) || !in.read(type.frameIndex) || !in.read(type.monetaryValue))
+            return false;
+    }
+
+    if (!in.readCount(count))
+        return false;
+
+    dinosaurs.resize(count);
+    for (DinosaurData& dino : dinosaurs)
+    {
+        if (!in.readString(dino.name) || !in.readString(dino.category) || !in.readString(dino.backgroundTexture) || !in.readString(dino.skinTexture))
+            return false;
+
+        std::uint32_t pieceCount = 0;
+        if (!in.readCount(pieceCount))
+            return false;
+
+        dino.pieces.resize(pieceCount);
+        for (DinosaurData::Piece& piece : dino.pieces)
+        {
+            if (!in.readString(piece.id) || !in.readString(piece.texturePath))
+                return false;
+        }
+    }
+
+    return in.atEnd();
+}
+
+void GameConfig::writeCache(const std::string& cachePath, std::uint64_t sourceSize, std::int64_t sourceTime) const
+{
+    BinaryWriter out;
+
+    out.write(CACHE_MAGIC);
+    out.write(CACHE_VERSION);
+    out.write(sourceSize);
+    out.write(sourceTime);
+
+    out.write(static_cast<std::uint32_t>(map.layers.size()));
+    for (const LayerType& layer : map.layers)
+    {
+        out.writeString(layer.name);
+        out.writeString(layer.texturePath);
+        out.write(layer.hardness);
+    }
+
+    out.writeString(map.cracks.texture);
+    out.write(map.cracks.frameWidth);
+    out.write(map.cracks.frameHeight);
+    out.write(map.cracks.frames);
+    out.write(map.hasSeed);
+    out.write(map.seed);
+
+    out.write(hasMuseum);
+    writeBuilding(out, museum);
+    out.write(hasTrader);
+    writeBuilding(out, trader);
+
+    out.write(static_cast<std::uint32_t>(collectibles.size()));
+    for (const CollectibleType& type : collectibles)
+    {
+        out.write(type.index);
+        out.writeString(type.name);
+        out.writeString(type.type);
+        out.writeString(type.texture);
+        out.write(type.frameWidth);
+        out.write(type.frameHeight);
+        out.write(type.frameIndex);
+        out.write(type.monetaryValue);
+    }
+
+    out.write(static_cast<std::uint32_t>(dinosaurs.size()));
+    for (const DinosaurData& dino : dinosaurs)
+    {
+        out.writeString(dino.name);
+        out.writeString(dino.category);
+        out.writeString(dino.backgroundTexture);
+        out.writeString(dino.skinTexture);
+
+        out.write(static_cast<std::uint32_t>(dino.pieces.size()));
+        for (const DinosaurData::Piece& piece : dino.pieces)
+        {
+            out.writeString(piece.id);
+            out.writeString(piece.texturePath);
+        }
+    }
+
+    std::ofstream file(cachePath, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        // not fatal, next run just parses the JSON again
+        std::cerr << "Could not write config cache: " << cachePath << "\n";
+        return;
+    }
+
+    file.write(out.getBuffer().data(), static_cast<std::streamsize>(out.getBuffer().size()));
+}
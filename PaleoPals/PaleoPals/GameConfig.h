@@ -0,0 +1,74 @@
+#pragma once
+#ifndef GAME_CONFIG_H
+#define GAME_CONFIG_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Fossil.h"
+
+struct LayerType
+{
+    std::string name;
+    std::string texturePath;
+    int hardness;
+};
+
+struct CrackConfig
+{
+    std::string texture = "ASSETS/IMAGES/Terrain/Cracks.png";
+    int frameWidth = 24;
+    int frameHeight = 24;
+    int frames = 5;
+};
+
+struct MapConfig
+{
+    std::vector<LayerType> layers;
+    CrackConfig cracks;
+    bool hasSeed = false;
+    std::uint64_t seed = 0;
+};
+
+// museum and trader share the same layout
+struct BuildingConfig
+{
+    std::string texture;
+    int frameWidth = 0;
+    int frameHeight = 0;
+    sf::Vector2f position;
+};
+
+// Everything in map.json as plain structs. The JSON is parsed once, checked,
+// and written out as a binary cache next to it (map.json.bin) that is loaded
+// instead on later runs for as long as the JSON is unchanged.
+class GameConfig
+{
+public:
+    bool loadFromFile(const std::string& jsonPath);
+
+    MapConfig map;
+
+    bool hasMuseum = false;
+    BuildingConfig museum;
+
+    bool hasTrader = false;
+    BuildingConfig trader;
+
+    std::vector<CollectibleType> collectibles;
+    std::vector<DinosaurData> dinosaurs;
+
+private:
+    bool parseJson(const std::string& jsonPath);
+    bool validate() const;
+
+    bool readCache(const std::string& cachePath, std::uint64_t sourceSize, std::int64_t sourceTime);
+    void writeCache(const std::string& cachePath, std::uint64_t sourceSize, std::int64_t sourceTime) const;
+
+    // bump whenever the cache layout changes so old caches are ignored
+    static const std::uint32_t CACHE_MAGIC = 0x46435050;   // "PPCF"
+    static const std::uint32_t CACHE_VERSION = 1;
+};
+
+#endif // !GAME_CONFIG_H
@@ -0,0 +1,240 @@
+#include "GridAStar.h"
+#include "Map.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+bool GridAStar::findPath(const Map& map, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path)
+{
+    return findPath(map.getSolidView(), start, goal, path);
+}
+
+bool GridAStar::findPath(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path)
+{
+    begin(grid, start, goal);
+    step(grid, std::numeric_limits<int>::max());
+    getPath(path);
+
+    return m_status == SearchStatus::Found;
+}
+
+void GridAStar::begin(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+    m_heap.clear();
+    m_lastExpanded = 0;
+    m_status = SearchStatus::Failed;
+
+    // start can be the tile a worker is standing in before it's dug, goal has to be open
+    if (start.x < 0 || start.y < 0 || start.y >= grid.rows || start.x >= grid.cols)
+        return;
+    if (!grid.isOpen(goal.y, goal.x))
+        return;
+
+    m_rows = grid.rows;
+    m_cols = grid.cols;
+    prepare(m_rows * m_cols);
+
+    m_goal = goal;
+    m_startCell = start.y * m_cols + start.x;
+    m_goalCell = goal.y * m_cols + goal.x;
+
+    m_stamp[m_startCell] = m_generation;
+    m_gCost[m_startCell] = 0;
+    m_hCost[m_startCell] = std::abs(start.x - goal.x) + std::abs(start.y - goal.y);
+    m_parent[m_startCell] = -1;
+    heapPush(m_startCell);
+
+    m_status = SearchStatus::Running;
+}
+
+SearchStatus GridAStar::step(const SolidGridView& source, int maxExpansions)
+{
+    if (m_status != SearchStatus::Running)
+        return m_status;
+
+    if (source.cols != m_cols)
+    {
+        m_heap.clear();
+        m_status = SearchStatus::Failed;
+        return m_status;
+    }
+
+    // rows streamed in after begin() have no buffer space yet
+    SolidGridView grid = source;
+    grid.rows = std::min(grid.rows, m_rows);
+
+    const int rowStep[4] = { 0, 0, 1, -1 };
+    const int colStep[4] = { 1, -1, 0, 0 };
+
+    int cols = m_cols;
+    int budget = maxExpansions;
+
+    while (!m_heap.empty())
+    {
+        if (budget-- <= 0)
+            return m_status;
+
+        int current = heapPop();
+        ++m_lastExpanded;
+
+        if (current == m_goalCell)
+        {
+            m_heap.clear();
+            m_status = SearchStatus::Found;
+            return m_status;
+        }
+
+        int row = current / cols;
+        int col = current % cols;
+        int nextCost = m_gCost[current] + 1;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextRow = row + rowStep[i];
+            int nextCol = col + colStep[i];
+
+            if (!grid.isOpen(nextRow, nextCol))
+                continue;
+
+            int next = nextRow * cols + nextCol;
+
+            if (!isCurrent(next))
+            {
+                m_stamp[next] = m_generation;
+                m_gCost[next] = nextCost;
+                m_hCost[next] = std::abs(nextCol - m_goal.x) + std::abs(nextRow - m_goal.y);
+                m_parent[next] = current;
+                heapPush(next);
+            }
+            else if (m_heapIndex[next] != CLOSED && nextCost < m_gCost[next])
+            {
+                m_gCost[next] = nextCost;
+                m_parent[next] = current;
+                heapDecrease(next);
+            }
+        }
+    }
+
+    m_status = SearchStatus::Failed;
+    return m_status;
+}
+
+void GridAStar::getPath(std::vector<sf::Vector2i>& path) const
+{
+    path.clear();
+
+    if (m_status != SearchStatus::Found)
+        return;
+
+    for (int cell = m_goalCell; cell != m_startCell; cell = m_parent[cell])
+    {
+        path.push_back(sf::Vector2i(cell % m_cols, cell / m_cols));
+    }
+
+    std::reverse(path.begin(), path.end());
+}
+
+void GridAStar::prepare(int cellCount)
+{
+    if (static_cast<int>(m_stamp.size()) < cellCount)
+    {
+        m_gCost.resize(cellCount);
+        m_hCost.resize(cellCount);
+        m_parent.resize(cellCount);
+        m_heapIndex.resize(cellCount);
+        m_stamp.resize(cellCount, 0);
+    }
+
+    // stamps only need clearing when the counter wraps, every ~4 billion queries
+    if (++m_generation == 0)
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_generation = 1;
+    }
+}
+
+bool GridAStar::heapLess(int a, int b) const
+{
+    int fa = m_gCost[a] + m_hCost[a];
+    int fb = m_gCost[b] + m_hCost[b];
+
+    if (fa != fb)
+        return fa < fb;
+    return m_hCost[a] < m_hCost[b];
+}
+
+void GridAStar::heapPush(int cell)
+{
+    m_heap.push_back(cell);
+    m_heapIndex[cell] = static_cast<int>(m_heap.size()) - 1;
+    siftUp(m_heapIndex[cell]);
+}
+
+int GridAStar::heapPop()
+{
+    int top = m_heap.front();
+    int last = m_heap.back();
+    m_heap.pop_back();
+
+    if (!m_heap.empty())
+    {
+        m_heap[0] = last;
+        m_heapIndex[last] = 0;
+        siftDown(0);
+    }
+
+    m_heapIndex[top] = CLOSED;
+    return top;
+}
+
+void GridAStar::heapDecrease(int cell)
+{
+    siftUp(m_heapIndex[cell]);
+}
+
+void GridAStar::siftUp(int position)
+{
+    int cell = m_heap[position];
+
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+
+        if (!heapLess(cell, m_heap[parent]))
+            break;
+
+        m_heap[position] = m_heap[parent];
+        m_heapIndex[m_heap[position]] = position;
+        position = parent;
+    }
+
+    m_heap[position] = cell;
+    m_heapIndex[cell] = position;
+}
+
+void GridAStar::siftDown(int position)
+{
+    int cell = m_heap[position];
+    int count = static_cast<int>(m_heap.size());
+
+    while (true)
+    {
+        int child = position * 2 + 1;
+
+        if (child >= count)
+            break;
+
+        if (child + 1 < count && heapLess(m_heap[child + 1], m_heap[child]))
+            ++child;
+
+        if (!heapLess(m_heap[child], cell))
+            break;
+
+        m_heap[position] = m_heap[child];
+        m_heapIndex[m_heap[position]] = position;
+        position = child;
+    }
+
+    m_heap[position] = cell;
+    m_heapIndex[cell] = position;
+}
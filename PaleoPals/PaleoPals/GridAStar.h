@@ -0,0 +1,71 @@
+#pragma once
+#ifndef GRID_ASTAR_H
+#define GRID_ASTAR_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include "SolidGrid.h"
+
+class Map;
+
+enum class SearchStatus
+{
+    Running,
+    Found,
+    Failed
+};
+
+// 4 way A* over a tile grid. Costs and parents live in flat arrays indexed by row * cols + col
+// and are stamped with a query generation, so starting a new search costs nothing and nothing
+// is allocated once the buffers have grown to the grid size.
+class GridAStar
+{
+public:
+    // path runs from the tile after start up to and including goal (x = col, y = row)
+    bool findPath(const Map& map, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path);
+    bool findPath(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path);
+
+    // the same search in slices, step expands at most maxExpansions nodes per call. the grid may
+    // gain open tiles or rows between steps, the search just keeps to the rows it started with
+    void begin(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal);
+    SearchStatus step(const SolidGridView& grid, int maxExpansions);
+    void getPath(std::vector<sf::Vector2i>& path) const;
+    SearchStatus getStatus() const { return m_status; }
+
+    // nodes expanded by the current / last search so far
+    int getLastExpanded() const { return m_lastExpanded; }
+
+private:
+    void prepare(int cellCount);
+    bool isCurrent(int cell) const { return m_stamp[cell] == m_generation; }
+
+    // indexed binary min heap on f, ties broken towards the goal
+    bool heapLess(int a, int b) const;
+    void heapPush(int cell);
+    int heapPop();
+    void heapDecrease(int cell);
+    void siftUp(int position);
+    void siftDown(int position);
+
+    std::vector<int> m_gCost;
+    std::vector<int> m_hCost;
+    std::vector<int> m_parent;
+    std::vector<int> m_heapIndex;           // position in m_heap, CLOSED once expanded
+    std::vector<std::uint32_t> m_stamp;     // cell data is only valid when this matches m_generation
+    std::uint32_t m_generation = 0;
+
+    std::vector<int> m_heap;
+
+    SearchStatus m_status = SearchStatus::Failed;
+    sf::Vector2i m_goal;
+    int m_startCell = -1;
+    int m_goalCell = -1;
+    int m_rows = 0;
+    int m_cols = 0;
+    int m_lastExpanded = 0;
+
+    static const int CLOSED = -1;
+};
+
+#endif // !GRID_ASTAR_H
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef GRID_TRAVERSAL_H
+#define GRID_TRAVERSAL_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+// Amanatides & Woo grid walk over a segment given in grid local pixels.
+// visit(col, row) is called once per cell crossed and returns false to stop early.
+template <typename Visit>
+void walkGridCells(sf::Vector2f localStart, sf::Vector2f localEnd, float tileSize, Visit visit)
+{
+    sf::Vector2f from = localStart / tileSize;
+    sf::Vector2f to = localEnd / tileSize;
+    sf::Vector2f delta = to - from;
+
+    int col = static_cast<int>(std::floor(from.x));
+    int row = static_cast<int>(std::floor(from.y));
+    int endCol = static_cast<int>(std::floor(to.x));
+    int endRow = static_cast<int>(std::floor(to.y));
+
+    int stepX = (delta.x > 0.f) ? 1 : ((delta.x < 0.f) ? -1 : 0);
+    int stepY = (delta.y > 0.f) ? 1 : ((delta.y < 0.f) ? -1 : 0);
+
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    // how far along the segment (0-1) one whole cell is on each axis
+    float tDeltaX = (stepX != 0) ? 1.f / std::abs(delta.x) : infinity;
+    float tDeltaY = (stepY != 0) ? 1.f / std::abs(delta.y) : infinity;
+
+    // how far along the segment the first vertical / horizontal grid line is
+    float tMaxX = (stepX > 0) ? (col + 1 - from.x) * tDeltaX : ((stepX < 0) ? (from.x - col) * tDeltaX : infinity);
+    float tMaxY = (stepY > 0) ? (row + 1 - from.y) * tDeltaY : ((stepY < 0) ? (from.y - row) * tDeltaY : infinity);
+
+    // one step per grid line crossed, so the walk ends exactly on the end cell
+    int cellCount = std::abs(endCol - col) + std::abs(endRow - row) + 1;
+
+    for (int i = 0; i < cellCount; ++i)
+    {
+        if (!visit(col, row))
+        {
+            return;
+        }
+
+        if (tMaxX < tMaxY)
+        {
+            col += stepX;
+            tMaxX += tDeltaX;
+        }
+        else
+        {
+            row += stepY;
+            tMaxY += tDeltaY;
+        }
+    }
+}
+
+// cells (x = col, y = row) a grid local segment passes through, in order, only those inside rows x cols
+inline void traverseGridCells(sf::Vector2f localStart, sf::Vector2f localEnd, float tileSize, int rows, int cols, std::vector<sf::Vector2i>& cells)
+{
+    cells.clear();
+
+    if (tileSize <= 0.f)
+    {
+        return;
+    }
+
+    walkGridCells(localStart, localEnd, tileSize, [&](int col, int row)
+        {
+            if (row >= 0 && col >= 0 && row < rows && col < cols)
+            {
+                cells.push_back(sf::Vector2i(col, row));
+            }
+            return true;
+        });
+}
+
+#endif // !GRID_TRAVERSAL_H
@@ -0,0 +1,488 @@
+#include "HierarchicalPathfinder.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+namespace
+{
+    int manhattan(sf::Vector2i a, sf::Vector2i b)
+    {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+
+    // runs shorter than this get one entrance in the middle, longer ones one at each end
+    const int LONG_ENTRANCE = 6;
+}
+
+void HierarchicalPathfinder::resize(int rows, int cols)
+{
+    if (rows <= 0 || cols <= 0)
+    {
+        m_rows = 0;
+        m_cols = 0;
+        m_chunkRows = 0;
+        m_chunkCols = 0;
+        m_chunks.clear();
+        m_dirtyChunks.clear();
+        return;
+    }
+
+    // a different width changes every chunk, start over
+    if (cols != m_cols)
+    {
+        resize(0, 0);
+    }
+
+    int oldRows = m_rows;
+
+    m_rows = rows;
+    m_cols = cols;
+    m_chunkRows = (rows + PATH_CHUNK_SIZE - 1) / PATH_CHUNK_SIZE;
+    m_chunkCols = (cols + PATH_CHUNK_SIZE - 1) / PATH_CHUNK_SIZE;
+    m_chunks.resize(static_cast<size_t>(m_chunkRows) * m_chunkCols);
+
+    // the old bottom chunk row either grew or gained a border underneath
+    int firstDirtyRow = std::max(0, (oldRows - 1) / PATH_CHUNK_SIZE);
+
+    for (int chunkRow = firstDirtyRow; chunkRow < m_chunkRows; ++chunkRow)
+    {
+        for (int chunkCol = 0; chunkCol < m_chunkCols; ++chunkCol)
+        {
+            markChunkDirty(chunkRow, chunkCol);
+        }
+    }
+}
+
+void HierarchicalPathfinder::markTileChanged(int row, int col)
+{
+    if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
+        return;
+
+    int chunkRow = row / PATH_CHUNK_SIZE;
+    int chunkCol = col / PATH_CHUNK_SIZE;
+    int localRow = row % PATH_CHUNK_SIZE;
+    int localCol = col % PATH_CHUNK_SIZE;
+
+    markChunkDirty(chunkRow, chunkCol);
+
+    // border tiles decide the entrances of the chunk on the other side too
+    if (localRow == 0)                   markChunkDirty(chunkRow - 1, chunkCol);
+    if (localRow == PATH_CHUNK_SIZE - 1) markChunkDirty(chunkRow + 1, chunkCol);
+    if (localCol == 0)                   markChunkDirty(chunkRow, chunkCol - 1);
+    if (localCol == PATH_CHUNK_SIZE - 1) markChunkDirty(chunkRow, chunkCol + 1);
+}
+
+void HierarchicalPathfinder::markChunkDirty(int chunkRow, int chunkCol)
+{
+    if (chunkRow < 0 || chunkCol < 0 || chunkRow >= m_chunkRows || chunkCol >= m_chunkCols)
+        return;
+
+    int index = chunkRow * m_chunkCols + chunkCol;
+
+    if (!m_chunks[index].dirty)
+    {
+        m_chunks[index].dirty = true;
+        m_dirtyChunks.push_back(index);
+    }
+}
+
+int HierarchicalPathfinder::rebuildDirtyChunks(const SolidGridView& grid, int maxChunks)
+{
+    if (grid.rows != m_rows || grid.cols != m_cols)
+    {
+        resize(grid.rows, grid.cols);
+    }
+
+    size_t count = maxChunks < 0 ? m_dirtyChunks.size() : std::min(m_dirtyChunks.size(), static_cast<size_t>(maxChunks));
+
+    int flooded = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        flooded += rebuildChunk(grid, m_dirtyChunks[i]);
+    }
+
+    m_dirtyChunks.erase(m_dirtyChunks.begin(), m_dirtyChunks.begin() + count);
+    return flooded;
+}
+
+int HierarchicalPathfinder::rebuildChunk(const SolidGridView& grid, int chunkIndex)
+{
+    PathChunk& chunk = m_chunks[chunkIndex];
+    chunk.nodes.clear();
+    chunk.dirty = false;
+
+    int top = (chunkIndex / m_chunkCols) * PATH_CHUNK_SIZE;
+    int left = (chunkIndex % m_chunkCols) * PATH_CHUNK_SIZE;
+    int bottom = std::min(top + PATH_CHUNK_SIZE, m_rows);
+    int right = std::min(left + PATH_CHUNK_SIZE, m_cols);
+
+    // borders are always scanned left to right / top to bottom so both sides agree on the entrances
+    if (top > 0)
+        addBorderNodes(grid, chunk, { left, top }, { 1, 0 }, { 0, -1 }, right - left);
+    if (bottom < m_rows)
+        addBorderNodes(grid, chunk, { left, bottom - 1 }, { 1, 0 }, { 0, 1 }, right - left);
+    if (left > 0)
+        addBorderNodes(grid, chunk, { left, top }, { 0, 1 }, { -1, 0 }, bottom - top);
+    if (right < m_cols)
+        addBorderNodes(grid, chunk, { right - 1, top }, { 0, 1 }, { 1, 0 }, bottom - top);
+
+    size_t count = chunk.nodes.size();
+    chunk.distances.assign(count * count, -1);
+    int flooded = 0;
+
+    for (size_t from = 0; from < count; ++from)
+    {
+        flooded += floodChunk(grid, chunkIndex, chunk.nodes[from].tile);
+
+        for (size_t to = 0; to < count; ++to)
+        {
+            chunk.distances[from * count + to] = localDistance(chunkIndex, chunk.nodes[to].tile);
+        }
+    }
+
+    return flooded;
+}
+
+void HierarchicalPathfinder::addBorderNodes(const SolidGridView& grid, PathChunk& chunk, sf::Vector2i first, sf::Vector2i along, sf::Vector2i across, int length)
+{
+    int runStart = -1;
+
+    for (int i = 0; i <= length; ++i)
+    {
+        sf::Vector2i tile = first + along * i;
+        sf::Vector2i partner = tile + across;
+        bool open = i < length && grid.isOpen(tile.y, tile.x) && grid.isOpen(partner.y, partner.x);
+
+        if (open && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if (!open && runStart >= 0)
+        {
+            int runLength = i - runStart;
+
+            if (runLength < LONG_ENTRANCE)
+            {
+                sf::Vector2i middle = first + along * (runStart + runLength / 2);
+                addNode(chunk, middle, middle + across);
+            }
+            else
+            {
+                sf::Vector2i startTile = first + along * runStart;
+                sf::Vector2i endTile = first + along * (i - 1);
+                addNode(chunk, startTile, startTile + across);
+                addNode(chunk, endTile, endTile + across);
+            }
+
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::addNode(PathChunk& chunk, sf::Vector2i tile, sf::Vector2i partner)
+{
+    // corner tiles can be an entrance on two borders at once
+    for (PathNode& node : chunk.nodes)
+    {
+        if (node.tile == tile)
+        {
+            if (node.linkCount < 2)
+                node.links[node.linkCount++] = partner;
+            return;
+        }
+    }
+
+    if (static_cast<int>(chunk.nodes.size()) >= MAX_CHUNK_NODES)
+        return;
+
+    PathNode node;
+    node.tile = tile;
+    node.links[0] = partner;
+    node.linkCount = 1;
+    chunk.nodes.push_back(node);
+}
+
+int HierarchicalPathfinder::findNode(int chunk, sf::Vector2i tile) const
+{
+    const std::vector<PathNode>& nodes = m_chunks[chunk].nodes;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].tile == tile)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+int HierarchicalPathfinder::floodChunk(const SolidGridView& grid, int chunk, sf::Vector2i from)
+{
+    int top = (chunk / m_chunkCols) * PATH_CHUNK_SIZE;
+    int left = (chunk % m_chunkCols) * PATH_CHUNK_SIZE;
+    int bottom = std::min(top + PATH_CHUNK_SIZE, m_rows);
+    int right = std::min(left + PATH_CHUNK_SIZE, m_cols);
+
+    m_localDistance.assign(PATH_CHUNK_SIZE * PATH_CHUNK_SIZE, -1);
+    m_floodQueue.clear();
+
+    // the start tile counts even if it's still solid, a worker can be stood in one it's digging
+    int startLocal = (from.y - top) * PATH_CHUNK_SIZE + (from.x - left);
+    m_localDistance[startLocal] = 0;
+    m_floodQueue.push_back(startLocal);
+
+    const int rowStep[4] = { 0, 0, 1, -1 };
+    const int colStep[4] = { 1, -1, 0, 0 };
+
+    for (size_t head = 0; head < m_floodQueue.size(); ++head)
+    {
+        int current = m_floodQueue[head];
+        int row = top + current / PATH_CHUNK_SIZE;
+        int col = left + current % PATH_CHUNK_SIZE;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextRow = row + rowStep[i];
+            int nextCol = col + colStep[i];
+
+            if (nextRow < top || nextRow >= bottom || nextCol < left || nextCol >= right)
+                continue;
+            if (!grid.isOpen(nextRow, nextCol))
+                continue;
+
+            int next = (nextRow - top) * PATH_CHUNK_SIZE + (nextCol - left);
+
+            if (m_localDistance[next] < 0)
+            {
+                m_localDistance[next] = m_localDistance[current] + 1;
+                m_floodQueue.push_back(next);
+            }
+        }
+    }
+
+    return static_cast<int>(m_floodQueue.size());
+}
+
+int HierarchicalPathfinder::localDistance(int chunk, sf::Vector2i tile) const
+{
+    int top = (chunk / m_chunkCols) * PATH_CHUNK_SIZE;
+    int left = (chunk % m_chunkCols) * PATH_CHUNK_SIZE;
+
+    return m_localDistance[(tile.y - top) * PATH_CHUNK_SIZE + (tile.x - left)];
+}
+
+bool HierarchicalPathfinder::findPath(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path)
+{
+    path.clear();
+    m_lastExpanded = 0;
+
+    if (start.x < 0 || start.y < 0 || start.y >= grid.rows || start.x >= grid.cols)
+        return false;
+    if (!grid.isOpen(goal.y, goal.x))
+        return false;
+
+    // short hops aren't worth the abstract graph
+    if (manhattan(start, goal) < PATH_CHUNK_SIZE * 2)
+    {
+        bool found = m_refiner.findPath(grid, start, goal, path);
+        m_lastExpanded = m_refiner.getLastExpanded();
+        return found;
+    }
+
+    if (!planWaypoints(grid, start, goal, m_waypoints))
+        return false;
+
+    // stitch the waypoints back together, crossing a border is a single step
+    sf::Vector2i previous = start;
+
+    for (sf::Vector2i waypoint : m_waypoints)
+    {
+        if (waypoint == previous)
+            continue;
+
+        if (manhattan(previous, waypoint) == 1)
+        {
+            path.push_back(waypoint);
+        }
+        else
+        {
+            if (!m_refiner.findPath(grid, previous, waypoint, m_segment))
+            {
+                path.clear();
+                return false;
+            }
+
+            m_lastExpanded += m_refiner.getLastExpanded();
+            path.insert(path.end(), m_segment.begin(), m_segment.end());
+        }
+
+        previous = waypoint;
+    }
+
+    return true;
+}
+
+bool HierarchicalPathfinder::planWaypoints(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& waypoints)
+{
+    m_lastExpanded = 0;
+
+    if (start.x < 0 || start.y < 0 || start.y >= grid.rows || start.x >= grid.cols)
+        return false;
+    if (!grid.isOpen(goal.y, goal.x))
+        return false;
+
+    // the plan is only right once every chunk is, whatever the per frame upkeep hasn't got to is paid for here
+    m_lastExpanded = rebuildDirtyChunks(grid);
+
+    if (!searchAbstract(grid, start, goal))
+        return false;
+
+    if (&waypoints != &m_waypoints)
+        waypoints = m_waypoints;
+
+    return true;
+}
+
+bool HierarchicalPathfinder::searchAbstract(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+    int nodeSlots = static_cast<int>(m_chunks.size()) * MAX_CHUNK_NODES;
+    int startNode = nodeSlots;
+    int goalNode = nodeSlots + 1;
+
+    if (static_cast<int>(m_stamp.size()) < nodeSlots + 2)
+    {
+        m_gCost.resize(nodeSlots + 2);
+        m_parent.resize(nodeSlots + 2);
+        m_stamp.resize(nodeSlots + 2, 0);
+        m_closedStamp.resize(nodeSlots + 2, 0);
+    }
+
+    if (++m_generation == 0)
+    {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        std::fill(m_closedStamp.begin(), m_closedStamp.end(), 0);
+        m_generation = 1;
+    }
+
+    int startChunk = chunkOf(start);
+    int goalChunk = chunkOf(goal);
+
+    // temporary edges from start and goal into the entrances of their own chunks
+    floodChunk(grid, startChunk, start);
+    m_startDistance.clear();
+    for (const PathNode& node : m_chunks[startChunk].nodes)
+    {
+        m_startDistance.push_back(localDistance(startChunk, node.tile));
+    }
+    int directDistance = startChunk == goalChunk ? localDistance(startChunk, goal) : -1;
+
+    floodChunk(grid, goalChunk, goal);
+    m_goalDistance.clear();
+    for (const PathNode& node : m_chunks[goalChunk].nodes)
+    {
+        m_goalDistance.push_back(localDistance(goalChunk, node.tile));
+    }
+
+    auto nodeTile = [&](int node)
+        {
+            if (node == startNode) return start;
+            if (node == goalNode) return goal;
+            return m_chunks[node / MAX_CHUNK_NODES].nodes[node % MAX_CHUNK_NODES].tile;
+        };
+
+    m_open.clear();
+
+    auto relax = [&](int from, int to, int cost)
+        {
+            int g = m_gCost[from] + cost;
+
+            if (m_stamp[to] != m_generation || g < m_gCost[to])
+            {
+                m_stamp[to] = m_generation;
+                m_gCost[to] = g;
+                m_parent[to] = from;
+                m_open.push_back({ g + manhattan(nodeTile(to), goal), to });
+                std::push_heap(m_open.begin(), m_open.end(), std::greater<std::pair<int, int>>());
+            }
+        };
+
+    m_stamp[startNode] = m_generation;
+    m_gCost[startNode] = 0;
+    m_parent[startNode] = -1;
+    m_open.push_back({ manhattan(start, goal), startNode });
+
+    bool found = false;
+
+    while (!m_open.empty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<std::pair<int, int>>());
+        int current = m_open.back().second;
+        m_open.pop_back();
+
+        // stale entry left behind by a cheaper push
+        if (m_closedStamp[current] == m_generation)
+            continue;
+
+        m_closedStamp[current] = m_generation;
+        ++m_lastExpanded;
+
+        if (current == goalNode)
+        {
+            found = true;
+            break;
+        }
+
+        if (current == startNode)
+        {
+            for (size_t i = 0; i < m_startDistance.size(); ++i)
+            {
+                if (m_startDistance[i] >= 0)
+                    relax(current, startChunk * MAX_CHUNK_NODES + static_cast<int>(i), m_startDistance[i]);
+            }
+
+            if (directDistance >= 0)
+                relax(current, goalNode, directDistance);
+
+            continue;
+        }
+
+        int chunkIndex = current / MAX_CHUNK_NODES;
+        int local = current % MAX_CHUNK_NODES;
+        const PathChunk& chunk = m_chunks[chunkIndex];
+        const PathNode& node = chunk.nodes[local];
+        size_t count = chunk.nodes.size();
+
+        for (size_t other = 0; other < count; ++other)
+        {
+            int distance = chunk.distances[local * count + other];
+
+            if (distance > 0)
+                relax(current, chunkIndex * MAX_CHUNK_NODES + static_cast<int>(other), distance);
+        }
+
+        for (int i = 0; i < node.linkCount; ++i)
+        {
+            int partnerChunk = chunkOf(node.links[i]);
+            int partner = findNode(partnerChunk, node.links[i]);
+
+            if (partner >= 0)
+                relax(current, partnerChunk * MAX_CHUNK_NODES + partner, 1);
+        }
+
+        if (chunkIndex == goalChunk && m_goalDistance[local] >= 0)
+            relax(current, goalNode, m_goalDistance[local]);
+    }
+
+    if (!found)
+        return false;
+
+    m_waypoints.clear();
+
+    for (int node = goalNode; node != startNode; node = m_parent[node])
+    {
+        m_waypoints.push_back(nodeTile(node));
+    }
+
+    std::reverse(m_waypoints.begin(), m_waypoints.end());
+    return true;
+}
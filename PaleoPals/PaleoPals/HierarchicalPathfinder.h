@@ -0,0 +1,93 @@
+#pragma once
+#ifndef HIERARCHICAL_PATHFINDER_H
+#define HIERARCHICAL_PATHFINDER_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <cstdint>
+#include "GridAStar.h"
+
+// path chunks line up with the terrain chunks (TERRAIN_CHUNK_SIZE)
+const int PATH_CHUNK_SIZE = 16;
+
+// Hierarchical A* (HPA*) over square chunks of the tile grid. Every open stretch along a
+// chunk border becomes an entrance with a node on each side, and the walking distance between
+// the nodes inside a chunk is cached. Long paths are planned over that small graph and then
+// refined tile by tile with GridAStar. Opening a tile only rebuilds its own chunk, plus the
+// neighbour across the border when the tile sits on one.
+class HierarchicalPathfinder
+{
+public:
+    void resize(int rows, int cols);
+    void markTileChanged(int row, int col);
+    // bring up to maxChunks dirty chunks up to date ahead of time, -1 for all of them.
+    // returns the tiles flooded doing it, roughly comparable to A* expansions
+    int rebuildDirtyChunks(const SolidGridView& grid, int maxChunks = -1);
+
+    // same contract as GridAStar::findPath
+    bool findPath(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path);
+    // just the coarse plan, the entrance tiles to pass through ending with goal, refined by the caller.
+    // chunks still dirty are rebuilt first and that counts towards getLastExpanded
+    bool planWaypoints(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& waypoints);
+
+    int getLastExpanded() const { return m_lastExpanded; }
+
+private:
+    // a tile just inside a chunk border, linked to its partner tile across it
+    struct PathNode
+    {
+        sf::Vector2i tile;
+        sf::Vector2i links[2];
+        int linkCount = 0;
+    };
+
+    struct PathChunk
+    {
+        std::vector<PathNode> nodes;
+        std::vector<int> distances;     // nodes x nodes walking distance inside the chunk, -1 if cut off
+        bool dirty = false;             // queued in m_dirtyChunks while set
+    };
+
+    // a chunk never has more entrance nodes than this, 4 borders x 8 entrances at worst
+    static const int MAX_CHUNK_NODES = 64;
+
+    int chunkOf(sf::Vector2i tile) const { return (tile.y / PATH_CHUNK_SIZE) * m_chunkCols + tile.x / PATH_CHUNK_SIZE; }
+    void markChunkDirty(int chunkRow, int chunkCol);
+    int rebuildChunk(const SolidGridView& grid, int chunk);
+    void addBorderNodes(const SolidGridView& grid, PathChunk& chunk, sf::Vector2i first, sf::Vector2i along, sf::Vector2i across, int length);
+    void addNode(PathChunk& chunk, sf::Vector2i tile, sf::Vector2i partner);
+    int findNode(int chunk, sf::Vector2i tile) const;
+
+    // bfs limited to one chunk, fills m_localDistance for every tile of it and returns how many it reached
+    int floodChunk(const SolidGridView& grid, int chunk, sf::Vector2i from);
+    int localDistance(int chunk, sf::Vector2i tile) const;
+
+    bool searchAbstract(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal);
+
+    int m_rows = 0;
+    int m_cols = 0;
+    int m_chunkRows = 0;
+    int m_chunkCols = 0;
+    std::vector<PathChunk> m_chunks;
+    std::vector<int> m_dirtyChunks;
+
+    // scratch reused by every query
+    std::vector<int> m_localDistance;
+    std::vector<int> m_floodQueue;
+    std::vector<int> m_startDistance;       // per node of the start chunk
+    std::vector<int> m_goalDistance;        // per node of the goal chunk
+
+    std::vector<int> m_gCost;
+    std::vector<int> m_parent;
+    std::vector<std::uint32_t> m_stamp;
+    std::vector<std::uint32_t> m_closedStamp;
+    std::uint32_t m_generation = 0;
+    std::vector<std::pair<int, int>> m_open;    // (f, node), lazy deletion
+    std::vector<sf::Vector2i> m_waypoints;
+    std::vector<sf::Vector2i> m_segment;
+
+    GridAStar m_refiner;
+    int m_lastExpanded = 0;
+};
+
+#endif // !HIERARCHICAL_PATHFINDER_H
@@ -1,131 +1,414 @@
 #include "Map.h"
 #include "Player.h"
+#include "GridTraversal.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <execution>
+#include <random>
 
-using json = nlohmann::json;
+namespace
+{
+    // splitmix64 finaliser, good avalanche for cheap
+    std::uint64_t mixBits(std::uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    // stateless random value in [0, 1) for one tile, same seed and cell always give the same number
+    float tileRandom(std::uint64_t seed, int row, int col)
+    {
+        std::uint64_t cell = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) | static_cast<std::uint32_t>(col);
+        std::uint64_t bits = mixBits(seed ^ mixBits(cell));
+        return static_cast<float>(bits >> 40) / static_cast<float>(1ull << 24);
+    }
+}
 
 Map::Map() {}
 
+Map::~Map()
+{
+    stopStreaming();
+}
+
 bool Map::loadMapFromConfig(const std::string& filepath)
 {
-    std::ifstream file(filepath);
+    // parsed once here (or read from the binary cache) and handed out as plain structs
+    GameConfig config;
 
-    if (!file.is_open())
+    if (!config.loadFromFile(filepath))
     {
-        std::cerr << "Failed to open JSON config: " << filepath << "\n";
+        std::cerr << "Failed to load map config: " << filepath << "\n";
         return false;
     }
 
-    try
+    // --- Terrain layers + crack frames ---
+    if (!loadTilePalette(config.map))
     {
-        json config;
-        file >> config;
-
-        // --- Terrain layers ---
-        for (auto& layerNode : config["map"]["layers"])
-        {
-            LayerType layer;
-            layer.name = layerNode["name"].get<std::string>();
-            layer.hardness = layerNode["hardness"].get<int>();
+        return false;
+    }
 
-            if (!layer.texture.loadFromFile(layerNode["texture"].get<std::string>()))
-            {
-                std::cerr << "Failed to load texture for layer: " << layer.name << "\n";
-                return false;
-            }
-            m_layerTypes.push_back(std::move(layer));
-        }
+    // --- World seed --- fixed in the config for repeatable runs, random otherwise
+    if (config.map.hasSeed)
+    {
+        m_worldSeed = config.map.seed;
+    }
+    else
+    {
+        std::random_device rd;
+        m_worldSeed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    }
+    std::cout << "World seed: " << m_worldSeed << "\n";
 
-        // --- Buildings ---
-        if (config.contains("museum"))
+    // --- Buildings ---
+    if (config.hasMuseum)
+    {
+        if (!m_museum.loadMuseumFromConfig(config.museum))
         {
-            if (!m_museum.loadMuseumFromConfig(config["museum"]))
-            {
-                std::cerr << "Failed to load museum\n";
-                return false;
-            }
+            std::cerr << "Failed to load museum\n";
+            return false;
         }
-        if (config.contains("trader"))
+    }
+    if (config.hasTrader)
+    {
+        if (!m_trader.loadTraderFromConfig(config.trader))
         {
-            if (!m_trader.loadTraderFromConfig(config["trader"]))
-            {
-                std::cerr << "Failed to load trader\n";
-                return false;
-            }
+            std::cerr << "Failed to load trader\n";
+            return false;
         }
+    }
+
+    // --- Collectible + dinosaur config ---
+    if (!m_fossilManager.loadFossilsFromConfig(config.collectibles, config.dinosaurs))
+    {
+        std::cerr << "Failed to load fossil config\n";
+        return false;
+    }
+
+    // the collectibles sheet shares the terrain atlas so pickups never switch textures either
+    if (!m_fossilManager.addSheetToAtlas(m_atlas))
+    {
+        std::cerr << "Failed to add collectibles to atlas\n";
+        return false;
+    }
+
+    if (!m_atlas.build())
+    {
+        std::cerr << "Failed to build terrain atlas\n";
+        return false;
+    }
 
-        // --- Collectible + dinosaur config ---
-        if (!m_fossilManager.loadFossilsFromConfig(filepath))
+    for (size_t i = 0; i < m_layerTypes.size(); ++i)
+    {
+        m_layerAtlasRects.push_back(m_atlas.getRect("layer" + std::to_string(i)));
+    }
+
+    // slice the crack strip into frames now the strip has a home in the atlas
+    sf::IntRect crackStrip = m_atlas.getRect("cracks");
+    for (sf::IntRect& frame : m_crackAtlasRects)
+    {
+        frame.position += crackStrip.position;
+    }
+
+    m_fossilManager.useAtlas(m_atlas);
+
+    return true;
+}
+
+bool Map::loadTilePalette(const MapConfig& mapConfig)
+{
+    // one atlas entry per layer, tiles just store the layer id
+    for (const LayerType& layer : mapConfig.layers)
+    {
+        if (!m_atlas.addImageFromFile("layer" + std::to_string(m_layerTypes.size()), layer.texturePath))
         {
-            std::cerr << "Failed to load fossil config\n";
+            std::cerr << "Failed to load texture for layer: " << layer.name << "\n";
             return false;
         }
+
+        m_layerHardness.push_back(layer.hardness);
+        m_layerTypes.push_back(layer);
     }
-    catch (const std::exception& e)
+
+    // crack overlay is a horizontal strip of frames, lightest damage first
+    std::string crackTexture = mapConfig.cracks.texture;
+    int frameWidth = mapConfig.cracks.frameWidth;
+    int frameHeight = mapConfig.cracks.frameHeight;
+    int frameCount = mapConfig.cracks.frames;
+
+    if (!m_atlas.addImageFromFile("cracks", crackTexture))
     {
-        std::cerr << "Error loading JSON map config: " << e.what() << "\n";
+        std::cerr << "Failed to load crack texture!\n";
         return false;
     }
 
-    // Crack overlay texture
-    if (!m_crackedOverlayTexture.loadFromFile("ASSETS/IMAGES/Terrain/Cracks.png"))
-        std::cerr << "Failed to load crack texture!\n";
+    // relative to the strip for now, moved into atlas space once the atlas is built
+    m_crackAtlasRects.clear();
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        m_crackAtlasRects.push_back(sf::IntRect({ frame * frameWidth, 0 }, { frameWidth, frameHeight }));
+    }
 
     return true;
 }
 
-void Map::generateGrid(int rows, int cols, float tileSize, float windowWidth, float windowHeight)
+void Map::resetGrid(int cols, float tileSize, float windowWidth, float windowHeight)
 {
+    m_tileLayer.clear();
+    m_tileHP.clear();
+    m_tileCrack.clear();
+    m_tileTints.clear();
+    m_solidBits.clear();
+    m_surfaceDistance.clear();
+    m_pathGraph.resize(0, 0);
+    m_openedTiles.clear();
+    m_components.clear();
+    m_ladders.clear();
+    m_chunks.clear();
+
+    m_rowsGenerated = 0;
+    m_rows = 0;
+    m_targetRows = 0;
+    m_tileSize = tileSize;
+    m_windowHeight = windowHeight;
+    m_windowWidth = windowWidth;
+    m_cols = cols;
+    m_solidWordsPerRow = (cols + 63) / 64;
+
+    float offsetY = m_windowHeight / 2.0f;
+    float offsetX = (m_windowWidth - (cols * tileSize)) / 2.0f;
+    m_gridOffset = sf::Vector2f(offsetX, offsetY);
+
+    m_fossilManager.cacheGridOffsets(offsetX, offsetY, tileSize);
+}
 
+void Map::generateGrid(int rows, int cols, float tileSize, float windowWidth, float windowHeight)
+{
     if (m_rowsGenerated == 0)
     {
-        m_tiles.clear();
-        m_tileSize = tileSize;
-        m_windowHeight = windowHeight;
-        m_windowWidth = windowWidth;
-        m_rows = rows;
-        m_cols = cols;
+        resetGrid(cols, tileSize, windowWidth, windowHeight);
     }
 
-    float offsetY = m_windowHeight / 2.0f;
-    float offsetX = (m_windowWidth - (cols * tileSize)) / 2.0f;
+    m_targetRows = std::max(m_targetRows, m_rowsGenerated + rows);
 
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    std::vector<std::uint8_t> layers;
+    generateLayerRows(m_rowsGenerated, rows, m_cols, m_worldSeed, layers);
+    appendRows(layers, rows);
+}
 
-    for (int row = m_rowsGenerated; row < m_rowsGenerated + rows; ++row)
-    {
-        for (int col = 0; col < cols; ++col)
+void Map::generateLayerRows(int firstRow, int rowCount, int cols, std::uint64_t seed, std::vector<std::uint8_t>& layers) const
+{
+    // pure data, no textures or map state touched so this is safe to run off the main thread
+    layers.resize(static_cast<size_t>(rowCount) * cols);
+
+    std::vector<int> rowOffsets(rowCount);
+    std::iota(rowOffsets.begin(), rowOffsets.end(), 0);
+
+    // every tile only depends on (seed, row, col) so rows can be split across cores in any order
+    std::for_each(std::execution::par, rowOffsets.begin(), rowOffsets.end(), [&](int rowOffset)
         {
-            int layerIndex = determineLayerAtDepth(row, m_rows);
+            int row = firstRow + rowOffset;
 
-            const LayerType& layer = m_layerTypes[layerIndex];
+            for (int col = 0; col < cols; ++col)
+            {
+                layers[rowOffset * cols + col] = static_cast<std::uint8_t>(determineLayerAtDepth(row, tileRandom(seed, row, col)));
+            }
+        });
+}
+
+int Map::getGeneratedLayer(int row, int col) const
+{
+    return determineLayerAtDepth(row, tileRandom(m_worldSeed, row, col));
+}
+
+void Map::appendRows(const std::vector<std::uint8_t>& layers, int rowCount)
+{
+    int firstNewRow = m_rowsGenerated;
+
+    size_t newTileCount = m_tileLayer.size() + layers.size();
+    m_tileLayer.reserve(newTileCount);
+    m_tileHP.reserve(newTileCount);
+    m_tileCrack.reserve(newTileCount);
+
+    size_t firstNewWord = m_solidBits.size();
+    m_solidBits.resize(firstNewWord + static_cast<size_t>(rowCount) * m_solidWordsPerRow, 0);
+
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (m_layerHardness[layers[i]] > 0)
+        {
+            int rowOffset = static_cast<int>(i) / m_cols;
+            int col = static_cast<int>(i) % m_cols;
+            m_solidBits[firstNewWord + static_cast<size_t>(rowOffset) * m_solidWordsPerRow + (col >> 6)] |= 1ull << (col & 63);
+        }
+    }
 
-            float yPos = row * tileSize + offsetY;
-            float xPos = col * tileSize + offsetX;
+    m_surfaceDistance.resize(m_surfaceDistance.size() + layers.size(), SURFACE_UNREACHABLE);
 
-            Tile newTile(layer.texture, sf::Vector2f(xPos, yPos), layer.hardness, m_crackedOverlayTexture);
+    for (std::uint8_t layerIndex : layers)
+    {
+        m_tileLayer.push_back(layerIndex);
+        m_tileHP.push_back(static_cast<std::uint16_t>(std::clamp(m_layerHardness[layerIndex], 0, 0xFFFF)));
+        m_tileCrack.push_back(0);
 
-            newTile.sprite.setScale(sf::Vector2f(tileSize / layer.texture.getSize().x, tileSize / layer.texture.getSize().y));
+        // Ensure ladder vector is in sync
+        m_ladders.push_back(false);
+    }
 
-            m_tiles.emplace_back(std::move(newTile));
+    m_rowsGenerated += rowCount;
+    m_rows = m_rowsGenerated;
+    m_components.resize(m_rows, m_cols);
 
-            // Ensure ladder vector is in sync
-            m_ladders.push_back(false);
+    // soft layers come out of generation already open, hook them into the surface field
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (m_layerHardness[layers[i]] <= 0)
+        {
+            relaxSurfaceDistance(firstNewRow + static_cast<int>(i) / m_cols, static_cast<int>(i) % m_cols);
+            m_components.open(firstNewRow + static_cast<int>(i) / m_cols, static_cast<int>(i) % m_cols);
         }
     }
 
-    m_rowsGenerated += rows;
+    resizeChunks();
+    m_pathGraph.resize(m_rows, m_cols);
+
+    // every chunk touching the new rows has to be baked again
+    for (int chunkRow = firstNewRow / TERRAIN_CHUNK_SIZE; chunkRow < m_chunkRows; ++chunkRow)
+    {
+        for (int chunkCol = 0; chunkCol < m_chunkCols; ++chunkCol)
+        {
+            m_chunks[chunkRow * m_chunkCols + chunkCol].dirty = true;
+        }
+    }
 
-    if (m_rowsGenerated >= m_rows)
+    if (m_rowsGenerated >= m_targetRows)
     {
-        m_fossilManager.cacheGridOffsets(offsetX, offsetY);
         std::cout << "Grid complete \n";
     }
 }
 
-int Map::determineLayerAtDepth(int row, int totalRows)
+void Map::startStreaming(int totalRows, int initialRows, int cols, float tileSize, float windowWidth, float windowHeight)
+{
+    stopStreaming();
+    resetGrid(cols, tileSize, windowWidth, windowHeight);
+
+    m_targetRows = totalRows;
+
+    // enough rows to stand on straight away, the rest comes from the worker
+    std::vector<std::uint8_t> layers;
+    int firstRows = std::min(initialRows, totalRows);
+    generateLayerRows(0, firstRows, m_cols, m_worldSeed, layers);
+    appendRows(layers, firstRows);
+
+    if (m_rowsGenerated >= m_targetRows)
+    {
+        return;
+    }
+
+    m_streamRequestedRows = m_rowsGenerated;
+    m_streamQueuedRows = m_rowsGenerated;
+    m_streamStop = false;
+
+    m_streamThread = std::thread(&Map::streamWorker, this, m_cols, m_targetRows, m_worldSeed);
+}
+
+void Map::updateStreaming(int deepestRow)
+{
+    if (!m_streamThread.joinable())
+    {
+        return;
+    }
+
+    GeneratedRowBlock block;
+    bool haveBlock = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+
+        // keep the worker a few blocks ahead of whoever is digging deepest
+        int wantedRows = std::min(m_targetRows, std::max(deepestRow, 0) + STREAM_AHEAD_ROWS);
+
+        if (wantedRows > m_streamRequestedRows)
+        {
+            m_streamRequestedRows = wantedRows;
+            m_streamCondition.notify_one();
+        }
+
+        // one block per frame keeps the hand over cost flat
+        if (!m_streamReady.empty() && m_streamReady.front().firstRow == m_rowsGenerated)
+        {
+            block = std::move(m_streamReady.front());
+            m_streamReady.pop_front();
+            haveBlock = true;
+        }
+    }
+
+    if (haveBlock)
+    {
+        appendRows(block.layers, block.rowCount);
+    }
+
+    if (m_rowsGenerated >= m_targetRows)
+    {
+        stopStreaming();
+    }
+}
+
+void Map::streamWorker(int cols, int totalRows, std::uint64_t seed)
+{
+    while (true)
+    {
+        GeneratedRowBlock block;
+
+        {
+            std::unique_lock<std::mutex> lock(m_streamMutex);
+
+            m_streamCondition.wait(lock, [this] { return m_streamStop || m_streamQueuedRows < m_streamRequestedRows; });
+
+            if (m_streamStop)
+            {
+                return;
+            }
+
+            block.firstRow = m_streamQueuedRows;
+            block.rowCount = std::min(STREAM_BLOCK_ROWS, totalRows - m_streamQueuedRows);
+            m_streamQueuedRows += block.rowCount;
+        }
+
+        generateLayerRows(block.firstRow, block.rowCount, cols, seed, block.layers);
+
+        {
+            std::lock_guard<std::mutex> lock(m_streamMutex);
+            m_streamReady.push_back(std::move(block));
+        }
+    }
+}
+
+void Map::stopStreaming()
+{
+    if (!m_streamThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+        m_streamStop = true;
+    }
+
+    m_streamCondition.notify_all();
+    m_streamThread.join();
+
+    m_streamReady.clear();
+    m_streamStop = false;
+}
+
+int Map::determineLayerAtDepth(int row, float randVal) const
 {
     if (row == 0)
     {
@@ -133,11 +416,9 @@ int Map::determineLayerAtDepth(int row, int totalRows)
     }
 
    
-    float depthRatio = static_cast<float>(row) / static_cast<float>(totalRows);
+    // measured against the original depth, not the streamed one, so a deeper map doesn't stretch the bands
+    float depthRatio = static_cast<float>(row) / static_cast<float>(LAYER_BAND_ROWS);
 
-   
-
-    float randVal = static_cast<float>(std::rand()) / RAND_MAX;
 
     if (depthRatio < 0.20f)
     {
@@ -233,21 +514,27 @@ void Map::removeTile(int row, int col)
 
 	int index = row * m_cols + col;
 
-    if (index < 0 || index >= static_cast<int>(m_tiles.size()))
+    if (index < 0 || index >= static_cast<int>(m_tileLayer.size()))
     {
 		return;
     }
 
-	Tile& tile = m_tiles[index];
-
-    if (tile.sprite.getColor() == sf::Color::Transparent)
+    if (m_tileLayer[index] == EMPTY_TILE_LAYER)
     {
         return;
     }
 
-	tile.sprite.setColor(sf::Color::Transparent);
-	tile.layerHardness = 0;
-	tile.currentHP = 0;
+	m_tileLayer[index] = EMPTY_TILE_LAYER;
+	m_tileHP[index] = 0;
+	m_tileCrack[index] = 0;
+    m_tileTints.erase(index);
+    m_solidBits[static_cast<size_t>(row) * m_solidWordsPerRow + (col >> 6)] &= ~(1ull << (col & 63));
+    relaxSurfaceDistance(row, col);
+    m_pathGraph.markTileChanged(row, col);
+    m_openedTiles.push_back(sf::Vector2i(col, row));
+    m_components.open(row, col);
+
+    markChunkDirty(row, col);
 
     m_fossilManager.trySpawnCollectible(row, col, m_tileSize, m_windowWidth, m_windowHeight);
 
@@ -264,10 +551,11 @@ void Map::colourTile(int row, int col, sf::Color color)
         return;
 
     int index = row * m_cols + col;
-    if (index < 0 || index >= static_cast<int>(m_tiles.size()))
+    if (index < 0 || index >= static_cast<int>(m_tileLayer.size()))
         return;
 
-    m_tiles[index].sprite.setColor(color);
+    m_tileTints[index] = color;
+    markChunkDirty(row, col);
 
 }
 
@@ -280,9 +568,10 @@ int Map::getTileHardness(int row, int col) const
 
     int index = row * m_cols + col;
 
-    if (index >= 0 && index < static_cast<int>(m_tiles.size()))
+    if (index >= 0 && index < static_cast<int>(m_tileLayer.size()))
     {
-        return m_tiles[index].layerHardness;
+        std::uint8_t layer = m_tileLayer[index];
+        return layer == EMPTY_TILE_LAYER ? 0 : m_layerHardness[layer];
     }
 
     return 0;
@@ -296,50 +585,100 @@ int Map::getTileCurrentHP(int row, int col) const
     int index = row * m_cols + col;
 
 
-    return m_tiles[index].currentHP;
+    return m_tileHP[index];
 }
 
 void Map::damageTile(int row, int col, int dmg)
 {
-    int index = row * m_cols + col;
-    Tile& t = m_tiles[index];
-
-    if (t.currentHP <= 0)
-        return;
-
-    t.currentHP -= dmg;
+    m_pendingDamage.push_back({ row, col, dmg });
+}
 
-    float hpPercent = static_cast<float>(t.currentHP) / t.layerHardness;
+void Map::damageTiles(const std::vector<TileDamage>& hits)
+{
+    m_pendingDamage.insert(m_pendingDamage.end(), hits.begin(), hits.end());
+}
 
-    if (hpPercent > 0.75f)
-    {
-        t.crackedFrameIndex = 0;
-    }
-    else if (hpPercent > 0.50f)
-    {
-        t.crackedFrameIndex = 1;
-    }
-    else if (hpPercent > 0.25f)
+void Map::resolveDamage()
+{
+    if (m_pendingDamage.empty())
     {
-        t.crackedFrameIndex = 2;
+        return;
     }
-    else if (hpPercent > 0.10f)
+
+    // fold every hit into one total per tile
+    m_damageScratch.clear();
+
+    for (const TileDamage& hit : m_pendingDamage)
     {
-        t.crackedFrameIndex = 3;
+        if (hit.row < 0 || hit.col < 0 || hit.row >= m_rows || hit.col >= m_cols || hit.damage <= 0)
+        {
+            continue;
+        }
+
+        m_damageScratch.push_back({ hit.row * m_cols + hit.col, hit.damage });
     }
-    else
+
+    m_pendingDamage.clear();
+
+    // sorted by tile index so the sweep below walks the tile arrays front to back
+    std::sort(m_damageScratch.begin(), m_damageScratch.end());
+
+    m_destroyedScratch.clear();
+
+    for (size_t i = 0; i < m_damageScratch.size();)
     {
-        t.crackedFrameIndex = 4;
-    }
+        int index = m_damageScratch[i].first;
+        int totalDamage = 0;
+
+        while (i < m_damageScratch.size() && m_damageScratch[i].first == index)
+        {
+            totalDamage += m_damageScratch[i].second;
+            ++i;
+        }
+
+        if (m_tileHP[index] == 0)
+        {
+            continue;
+        }
+
+        int currentHP = std::max(0, m_tileHP[index] - totalDamage);
+        m_tileHP[index] = static_cast<std::uint16_t>(currentHP);
+
+        float hpPercent = static_cast<float>(currentHP) / m_layerHardness[m_tileLayer[index]];
 
-    int frameWidth = 24; 
+        if (hpPercent > 0.75f)
+        {
+            m_tileCrack[index] = 0;
+        }
+        else if (hpPercent > 0.50f)
+        {
+            m_tileCrack[index] = 1;
+        }
+        else if (hpPercent > 0.25f)
+        {
+            m_tileCrack[index] = 2;
+        }
+        else if (hpPercent > 0.10f)
+        {
+            m_tileCrack[index] = 3;
+        }
+        else
+        {
+            m_tileCrack[index] = 4;
+        }
 
-    t.crackedSprite.setTextureRect(sf::IntRect({ t.crackedFrameIndex * frameWidth, 0 }, { frameWidth, frameWidth }));
+        markChunkDirty(index / m_cols, index % m_cols);
 
+        if (currentHP <= 0)
+        {
+            m_destroyedScratch.push_back(index);
+        }
+    }
 
-    if (t.currentHP <= 0)
+    // removals last, this is where drops get rolled
+    for (int index : m_destroyedScratch)
     {
-		removeTile(row, col);      
+        removeTile(index / m_cols, index % m_cols);
     }
 }
 
@@ -352,26 +691,34 @@ void Map::drawMap(sf::RenderWindow& window)
     sf::Vector2f viewSize = currentView.getSize();
     sf::FloatRect viewBounds(sf::Vector2f(viewCenter.x - viewSize.x / 2.f, viewCenter.y - viewSize.y / 2.f), viewSize);
 
-    for (int i = 0; i < static_cast<int>(m_tiles.size()); ++i)
+    TileRange visible = getVisibleTileRange(currentView);
+
+    if (!visible.isEmpty())
     {
-        const Tile& tile = m_tiles[i];
-        
-        if (!viewBounds.findIntersection(tile.sprite.getGlobalBounds()))
+        int firstChunkRow = visible.firstRow / TERRAIN_CHUNK_SIZE;
+        int lastChunkRow = (visible.lastRow - 1) / TERRAIN_CHUNK_SIZE;
+        int firstChunkCol = visible.firstCol / TERRAIN_CHUNK_SIZE;
+        int lastChunkCol = (visible.lastCol - 1) / TERRAIN_CHUNK_SIZE;
+
+        for (int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; ++chunkRow)
         {
-            continue;
-        }
+            for (int chunkCol = firstChunkCol; chunkCol <= lastChunkCol; ++chunkCol)
+            {
+                TerrainChunk& chunk = m_chunks[chunkRow * m_chunkCols + chunkCol];
 
-        window.draw(tile.sprite);
+                // only rebake chunks that were touched since the last time they were drawn
+                if (chunk.dirty)
+                {
+                    rebuildChunk(chunkRow, chunkCol);
+                }
 
-        if (tile.currentHP > 0 && tile.crackedFrameIndex > 0)
-        {
-			window.draw(tile.crackedSprite);
+                window.draw(chunk.vertices, &m_atlas.getTexture());
+            }
         }
-
-        
     }
 
-    m_fossilManager.drawCollectibles(window);
+    // pad by a few tiles so half visible pickups on the edge still draw
+    m_fossilManager.drawCollectibles(window, getVisibleTileRange(currentView, 4));
 
     if (viewBounds.findIntersection(m_museum.getSprite().getGlobalBounds()))
     {
@@ -384,6 +731,99 @@ void Map::drawMap(sf::RenderWindow& window)
     }
 }
 
+void Map::resizeChunks()
+{
+    m_chunkCols = (m_cols + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+    m_chunkRows = (m_rowsGenerated + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+
+    m_chunks.resize(static_cast<size_t>(m_chunkRows) * m_chunkCols);
+}
+
+void Map::markChunkDirty(int row, int col)
+{
+    int chunkRow = row / TERRAIN_CHUNK_SIZE;
+    int chunkCol = col / TERRAIN_CHUNK_SIZE;
+
+    if (chunkRow < 0 || chunkCol < 0 || chunkRow >= m_chunkRows || chunkCol >= m_chunkCols)
+    {
+        return;
+    }
+
+    m_chunks[chunkRow * m_chunkCols + chunkCol].dirty = true;
+}
+
+void Map::rebuildChunk(int chunkRow, int chunkCol)
+{
+    TerrainChunk& chunk = m_chunks[chunkRow * m_chunkCols + chunkCol];
+    chunk.vertices.clear();
+
+    float offsetY = m_gridOffset.y;
+    float offsetX = m_gridOffset.x;
+
+    int rowStart = chunkRow * TERRAIN_CHUNK_SIZE;
+    int colStart = chunkCol * TERRAIN_CHUNK_SIZE;
+    int rowEnd = std::min(rowStart + TERRAIN_CHUNK_SIZE, m_rowsGenerated);
+    int colEnd = std::min(colStart + TERRAIN_CHUNK_SIZE, m_cols);
+
+    for (int row = rowStart; row < rowEnd; ++row)
+    {
+        for (int col = colStart; col < colEnd; ++col)
+        {
+            int index = row * m_cols + col;
+            std::uint8_t layer = m_tileLayer[index];
+
+            // removed tiles leave a hole in the mesh
+            if (layer == EMPTY_TILE_LAYER)
+            {
+                continue;
+            }
+
+            sf::Vector2f pos(col * m_tileSize + offsetX, row * m_tileSize + offsetY);
+
+            sf::Color tint = sf::Color::White;
+            if (!m_tileTints.empty())
+            {
+                auto it = m_tileTints.find(index);
+                if (it != m_tileTints.end())
+                {
+                    tint = it->second;
+                }
+            }
+
+            appendQuad(chunk.vertices, pos, m_tileSize, m_layerAtlasRects[layer], tint);
+
+            // crack overlay sits straight after its tile so it draws on top
+            int crackFrame = m_tileCrack[index];
+            if (m_tileHP[index] > 0 && crackFrame > 0 && crackFrame < static_cast<int>(m_crackAtlasRects.size()))
+            {
+                appendQuad(chunk.vertices, pos, m_tileSize, m_crackAtlasRects[crackFrame], sf::Color::White);
+            }
+        }
+    }
+
+    chunk.dirty = false;
+}
+
+void Map::appendQuad(sf::VertexArray& vertices, sf::Vector2f pos, float size, const sf::IntRect& texRect, sf::Color color)
+{
+    sf::Vector2f texPos(texRect.position);
+    sf::Vector2f texSize(texRect.size);
+
+    sf::Vertex topLeft{ pos, color, texPos };
+    sf::Vertex topRight{ pos + sf::Vector2f(size, 0.f), color, texPos + sf::Vector2f(texSize.x, 0.f) };
+    sf::Vertex bottomRight{ pos + sf::Vector2f(size, size), color, texPos + texSize };
+    sf::Vertex bottomLeft{ pos + sf::Vector2f(0.f, size), color, texPos + sf::Vector2f(0.f, texSize.y) };
+
+    // two triangles per quad, sfml 3 has no quad primitive
+    vertices.append(topLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+
+    vertices.append(topLeft);
+    vertices.append(bottomRight);
+    vertices.append(bottomLeft);
+}
+
 void Map::toggleDebugMode()
 {
     m_debugMode = !m_debugMode;
@@ -405,11 +845,11 @@ void Map::updateHover(const sf::RenderWindow& window, float tileSize, int cols)
     sf::Vector2i mousePixel = sf::Mouse::getPosition(window);
     sf::Vector2f mouseWorld = window.mapPixelToCoords(mousePixel);
 
-    int rows = static_cast<int>(m_tiles.size() / cols);
+    int rows = static_cast<int>(m_tileLayer.size() / cols);
     float totalGridHeight = rows * tileSize;
     float totalGridWidth = cols * tileSize;
-    float offsetY = WINDOW_Y / 2.0f;
-    float offsetX = (WINDOW_X - totalGridWidth) / 2.0f;
+    float offsetY = m_gridOffset.y;
+    float offsetX = m_gridOffset.x;
 
 
     float localX = mouseWorld.x - offsetX;
@@ -425,30 +865,12 @@ void Map::updateHover(const sf::RenderWindow& window, float tileSize, int cols)
     int tileY = static_cast<int>(localY / tileSize);
     int index = tileY * cols + tileX;
 
-    if (index >= 0 && index < static_cast<int>(m_tiles.size()))
+    if (index >= 0 && index < static_cast<int>(m_tileLayer.size()))
     {
-        if (index != m_hoveredIndex)
-        {
-            m_hoveredIndex = index;
-
-            const Tile& hoveredTile = m_tiles[m_hoveredIndex];
-            std::string tileName = "Unknown";
-            int tileHardness = hoveredTile.layerHardness;
+        m_hoveredIndex = index;
 
-            for (const auto& layer : m_layerTypes)
-            {
-                if (layer.hardness == hoveredTile.layerHardness)
-                {
-                    tileName = layer.name;
-                    break;
-                }
-            }
-
-        }
-
-        const Tile& hoveredTile = m_tiles[m_hoveredIndex];
         m_hoverOutline.setSize(sf::Vector2f(tileSize, tileSize));
-        m_hoverOutline.setPosition(hoveredTile.sprite.getPosition());
+        m_hoverOutline.setPosition(sf::Vector2f(tileX * tileSize + offsetX, tileY * tileSize + offsetY));
         m_hoverOutline.setFillColor(sf::Color::Transparent);
         m_hoverOutline.setOutlineColor(sf::Color::White);
         m_hoverOutline.setOutlineThickness(1.f);
@@ -472,11 +894,11 @@ void Map::handleMouseHold(const sf::RenderWindow& window, float tileSize, int co
     sf::Vector2i mousePixel = sf::Mouse::getPosition(window);
     sf::Vector2f mouseWorld = window.mapPixelToCoords(mousePixel);
 
-    int rows = static_cast<int>(m_tiles.size() / cols);
+    int rows = static_cast<int>(m_tileLayer.size() / cols);
     float totalGridHeight = rows * tileSize;
     float totalGridWidth = cols * tileSize;
-    float offsetY = WINDOW_Y / 2.0f;
-    float offsetX = (WINDOW_X - totalGridWidth) / 2.0f;
+    float offsetY = m_gridOffset.y;
+    float offsetX = m_gridOffset.x;
 
     float localX = mouseWorld.x - offsetX;
     float localY = mouseWorld.y - offsetY;
@@ -490,9 +912,9 @@ void Map::handleMouseHold(const sf::RenderWindow& window, float tileSize, int co
     int tileY = static_cast<int>(localY / tileSize);
     int index = tileY * cols + tileX;
 
-    if (index >= 0 && index < static_cast<int>(m_tiles.size()))
+    if (index >= 0 && index < static_cast<int>(m_tileLayer.size()))
     {
-        if (m_tiles[index].sprite.getColor() != sf::Color::Transparent)
+        if (m_tileLayer[index] != EMPTY_TILE_LAYER)
         {
             removeTile(tileY, tileX);
         }
@@ -509,11 +931,32 @@ void Map::drawDebug(sf::RenderWindow& window)
 
 sf::Vector2f Map::tileToWorld(sf::Vector2i tilePos) const
 {
-    float x = tilePos.x * m_tileSize + (m_windowWidth - m_cols * m_tileSize) / 2.0f + m_tileSize / 2.0f;
-    float y = tilePos.y * m_tileSize + m_windowHeight / 2.0f + m_tileSize / 2.0f;
+    float x = tilePos.x * m_tileSize + m_gridOffset.x + m_tileSize / 2.0f;
+    float y = tilePos.y * m_tileSize + m_gridOffset.y + m_tileSize / 2.0f;
     return sf::Vector2f(x, y);
 }
 
+TileRange Map::getVisibleTileRange(const sf::View& view, int padTiles) const
+{
+    TileRange range;
+
+    if (m_tileSize <= 0.f)
+    {
+        return range;
+    }
+
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.f - m_gridOffset;
+    sf::Vector2f bottomRight = topLeft + view.getSize();
+
+    // straight from the view edges to grid indices, no per tile tests
+    range.firstCol = std::max(0, static_cast<int>(std::floor(topLeft.x / m_tileSize)) - padTiles);
+    range.firstRow = std::max(0, static_cast<int>(std::floor(topLeft.y / m_tileSize)) - padTiles);
+    range.lastCol = std::min(m_cols, static_cast<int>(std::floor(bottomRight.x / m_tileSize)) + 1 + padTiles);
+    range.lastRow = std::min(m_rowsGenerated, static_cast<int>(std::floor(bottomRight.y / m_tileSize)) + 1 + padTiles);
+
+    return range;
+}
+
 bool Map::isPointOnTrader(const sf::Vector2f& worldPos) const
 {
     return m_trader.containsPoint(worldPos);
@@ -568,34 +1011,190 @@ bool Map::hasLadder(int row, int col) const
 
 bool Map::isWalkable(int row, int col) const
 {
-    // Walkable if inside bounds and hardness == 0 (dug) OR has ladder
+    // walkable once dug out, anything outside the grid is not
     if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
         return false;
 
-    int index = row * m_cols + col;
-    if (index < 0 || index >= static_cast<int>(m_tiles.size()))
-        return false;
+    return !isSolid(row, col);
+}
 
-    const Tile& t = m_tiles[index];
+bool Map::anySolidInRect(const TileRange& range) const
+{
+    int firstRow = std::max(range.firstRow, 0);
+    int lastRow = std::min(range.lastRow, m_rows);
+    int firstCol = std::max(range.firstCol, 0);
+    int lastCol = std::min(range.lastCol, m_cols);
 
-    // Solid if hardness > 0
-    if (t.layerHardness > 0)
+    if (firstRow >= lastRow || firstCol >= lastCol)
+    {
         return false;
+    }
 
-    // Dug tile or ladder tile is walkable
-    return true;
+    int firstWord = firstCol >> 6;
+    int lastWord = (lastCol - 1) >> 6;
+
+    // 64 tiles per test
+    for (int row = firstRow; row < lastRow; ++row)
+    {
+        const std::uint64_t* words = getSolidRow(row);
+
+        for (int word = firstWord; word <= lastWord; ++word)
+        {
+            if (words[word] & columnMask(word, firstCol, lastCol))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
-sf::Vector2i Map::worldToTile(sf::Vector2f worldPos) const
+int Map::countSolidInRow(int row, int firstCol, int lastCol) const
 {
-    float offsetY = m_windowHeight / 2.0f;
-    float offsetX = (m_windowWidth - (m_cols * m_tileSize)) / 2.0f;
+    return getSolidView().countSolidInRow(row, firstCol, lastCol);
+}
+
+int Map::firstSolidBelow(int row, int col) const
+{
+    return getSolidView().firstSolidBelow(row, col);
+}
 
-    float localX = worldPos.x - offsetX;
-    float localY = worldPos.y - offsetY;
+sf::Vector2i Map::worldToTile(sf::Vector2f worldPos) const
+{
+    float localX = worldPos.x - m_gridOffset.x;
+    float localY = worldPos.y - m_gridOffset.y;
 
     int col = static_cast<int>((localX / m_tileSize));
     int row = static_cast<int>((localY / m_tileSize));
 
     return sf::Vector2i(col, row);
 }
+
+void Map::traverseCells(sf::Vector2f start, sf::Vector2f end, std::vector<sf::Vector2i>& cells) const
+{
+    traverseGridCells(start - m_gridOffset, end - m_gridOffset, m_tileSize, m_rows, m_cols, cells);
+}
+
+bool Map::raycastFirstSolid(sf::Vector2f start, sf::Vector2f end, sf::Vector2i& hitCell) const
+{
+    if (m_tileSize <= 0.f)
+    {
+        return false;
+    }
+
+    bool hit = false;
+
+    walkGridCells(start - m_gridOffset, end - m_gridOffset, m_tileSize, [&](int col, int row)
+        {
+            if (isSolid(row, col))
+            {
+                hitCell = sf::Vector2i(col, row);
+                hit = true;
+                return false;
+            }
+            return true;
+        });
+
+    return hit;
+}
+
+int Map::getSurfaceDistance(int row, int col) const
+{
+    if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
+        return SURFACE_UNREACHABLE;
+
+    return m_surfaceDistance[static_cast<size_t>(row) * m_cols + col];
+}
+
+bool Map::stepTowardSurface(sf::Vector2i tile, sf::Vector2i& next) const
+{
+    int distance = getSurfaceDistance(tile.y, tile.x);
+
+    if (distance == 0 || distance == SURFACE_UNREACHABLE)
+        return false;
+
+    // any neighbour one closer will do, up first so shafts are climbed straight
+    const sf::Vector2i steps[4] = { { 0, -1 }, { -1, 0 }, { 1, 0 }, { 0, 1 } };
+
+    for (const sf::Vector2i& step : steps)
+    {
+        sf::Vector2i neighbour = tile + step;
+
+        if (getSurfaceDistance(neighbour.y, neighbour.x) == distance - 1)
+        {
+            next = neighbour;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Map::relaxSurfaceDistance(int row, int col)
+{
+    const int rowStep[4] = { -1, 1, 0, 0 };
+    const int colStep[4] = { 0, 0, -1, 1 };
+
+    int index = row * m_cols + col;
+
+    // the opened tile takes the best of its neighbours, row 0 is the surface itself
+    int best = row == 0 ? 0 : SURFACE_UNREACHABLE;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int neighbour = getSurfaceDistance(row + rowStep[i], col + colStep[i]);
+
+        if (neighbour != SURFACE_UNREACHABLE)
+            best = std::min(best, neighbour + 1);
+    }
+
+    if (best >= m_surfaceDistance[index])
+        return;
+
+    m_surfaceDistance[index] = best;
+
+    // every edge costs one so a plain queue keeps this in dijkstra order
+    m_surfaceQueue.clear();
+    m_surfaceQueue.push_back(index);
+
+    for (size_t head = 0; head < m_surfaceQueue.size(); ++head)
+    {
+        int current = m_surfaceQueue[head];
+        int currentRow = current / m_cols;
+        int currentCol = current % m_cols;
+        int nextDistance = m_surfaceDistance[current] + 1;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextRow = currentRow + rowStep[i];
+            int nextCol = currentCol + colStep[i];
+
+            if (!isWalkable(nextRow, nextCol))
+                continue;
+
+            int next = nextRow * m_cols + nextCol;
+
+            if (nextDistance < m_surfaceDistance[next])
+            {
+                m_surfaceDistance[next] = nextDistance;
+                m_surfaceQueue.push_back(next);
+            }
+        }
+    }
+}
+
+bool Map::findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path)
+{
+    return m_pathGraph.findPath(getSolidView(), start, goal, path);
+}
+
+int Map::getComponent(int row, int col) const
+{
+    return m_components.getComponent(row, col);
+}
+
+bool Map::isReachable(sf::Vector2i from, sf::Vector2i to) const
+{
+    return m_components.isReachable(getSolidView(), from, to);
+}
@@ -5,47 +5,61 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
-#include <json.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "constants.h"
+#include "GameConfig.h"
 #include "Museum.h"
 #include "Trader.h"
 #include "Fossil.h"
+#include "TextureAtlas.h"
+#include "HierarchicalPathfinder.h"
+#include "TileComponents.h"
 
 class Player;
 
-struct LayerType
+// terrain is baked into square chunks so a visible chunk costs one draw call
+const int TERRAIN_CHUNK_SIZE = 16;
+
+// streamed generation works in blocks of rows and tries to stay this far below the deepest digger
+const int STREAM_BLOCK_ROWS = 32;
+const int STREAM_AHEAD_ROWS = 96;
+
+// the layer bands were tuned for a dig site this deep, they stay at these absolute rows
+// however deep the map streams and everything below the last band is the bottom layer mix
+const int LAYER_BAND_ROWS = 215;
+
+// layer id stored for tiles that have been dug out
+const std::uint8_t EMPTY_TILE_LAYER = 0xFF;
+
+// surface distance for tiles that are solid or have no dug out route to row 0
+const int SURFACE_UNREACHABLE = 0x7FFFFFFF;
+
+// one hit on one tile, queued during the tick and resolved by Map::resolveDamage
+struct TileDamage
 {
-    std::string name;
-    sf::Texture texture;
-    int hardness;
+    int row = 0;
+    int col = 0;
+    int damage = 0;
 };
 
-class Tile
+// rows made by the streaming worker, waiting to be appended on the main thread
+struct GeneratedRowBlock
 {
-public:
-    sf::Sprite sprite;
-    sf::Sprite crackedSprite;
-    int currentHP = 0;
-    int layerHardness = 0;
-    int crackedFrameIndex = 0;
-
-
-
-    // Constructor 
-    Tile(const sf::Texture& texture,
-        const sf::Vector2f& pos,
-        int hardnessValue,
-        const sf::Texture& crackTexture)
-        : sprite(texture),
-        layerHardness(hardnessValue),
-        currentHP(hardnessValue),
-		crackedSprite(crackTexture)
-    {
-        sprite.setPosition(pos);
-		crackedSprite.setPosition(pos);
-    }
+    int firstRow = 0;
+    int rowCount = 0;
+    std::vector<std::uint8_t> layers;
+};
 
-    Tile() = delete;
+// one baked block of TERRAIN_CHUNK_SIZE x TERRAIN_CHUNK_SIZE tiles, drawn with the terrain atlas
+struct TerrainChunk
+{
+    sf::VertexArray vertices{ sf::PrimitiveType::Triangles };
+    bool dirty = true;
 };
 
 
@@ -53,9 +67,20 @@ class Map
 {
 public:
     Map();
+    ~Map();
     bool loadMapFromConfig(const std::string& filepath);
     void generateGrid(int rows, int cols, float tileSize, float windowWidth, float windowHeight);
-    int determineLayerAtDepth(int row, int totalRows);
+    int determineLayerAtDepth(int row, float randVal) const;
+
+    // layer a tile is generated with, a pure function of the world seed so any chunk can be rebuilt
+    int getGeneratedLayer(int row, int col) const;
+    void setWorldSeed(std::uint64_t seed) { m_worldSeed = seed; }
+    std::uint64_t getWorldSeed() const { return m_worldSeed; }
+
+    // generates initialRows now and the rest of totalRows on a worker thread as digging gets deeper
+    void startStreaming(int totalRows, int initialRows, int cols, float tileSize, float windowWidth, float windowHeight);
+    void updateStreaming(int deepestRow);
+    bool isStreaming() const { return m_streamThread.joinable(); }
     void setupBackground();
 
     void removeTile(int row, int col);
@@ -67,7 +92,10 @@ public:
     int getTileHardness(int row, int col) const;
     int getTileCurrentHP(int row, int col) const;
 
+    // damage is only queued here, resolveDamage applies everything from every digger once per tick
     void damageTile(int row, int col, int dmg);
+    void damageTiles(const std::vector<TileDamage>& hits);
+    void resolveDamage();
 
     void drawMap(sf::RenderWindow& window);
     void drawDebug(sf::RenderWindow& window);
@@ -78,18 +106,24 @@ public:
 
     sf::Vector2f tileToWorld(sf::Vector2i tilePos) const;
 
+    // tiles covered by a view, clamped to the generated grid and grown by padTiles on each side
+    TileRange getVisibleTileRange(const sf::View& view, int padTiles = 0) const;
+    sf::Vector2f getGridOffset() const { return m_gridOffset; }
+
 
     void updateMuseum(sf::RenderWindow& window);
     void updateTrader(sf::RenderWindow& window);
 
     bool isPointOnTrader(const sf::Vector2f& worldPos) const;
 
-    int getRowCount() const { return m_rows; }
+    int getRowCount() const { return m_rows; }            // rows generated so far
+    int getTargetRowCount() const { return m_targetRows; } // full depth once streaming finishes
     int getColumnCount() const { return m_cols; }
     float getTileSize() const { return m_tileSize; }
 
     //fossil system
     FossilManager& getFossilManager() { return m_fossilManager; }
+    HierarchicalPathfinder& getPathGraph() { return m_pathGraph; }
     Museum& getMuseum() { return m_museum; }
     Trader& getTrader() { return m_trader; }
 
@@ -98,26 +132,122 @@ public:
     bool hasLadder(int row, int col) const;
 
     bool isWalkable(int row, int col) const;
+
+    // solid occupancy, one bit per tile packed into 64 bit words per row
+    bool isSolid(int row, int col) const
+    {
+        if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
+            return false;
+        return (m_solidBits[static_cast<size_t>(row) * m_solidWordsPerRow + (col >> 6)] >> (col & 63)) & 1u;
+    }
+    bool anySolidInRect(const TileRange& range) const;
+    int countSolidInRow(int row, int firstCol, int lastCol) const;   // cols in [firstCol, lastCol)
+    int firstSolidBelow(int row, int col) const;                      // first solid row at or below row, -1 if none
+    const std::uint64_t* getSolidRow(int row) const { return m_solidBits.data() + static_cast<size_t>(row) * m_solidWordsPerRow; }
+    int getSolidWordsPerRow() const { return m_solidWordsPerRow; }
+    SolidGridView getSolidView() const { return SolidGridView{ m_solidBits.data(), m_solidWordsPerRow, m_rows, m_cols }; }
+
+    // walking path over dug out tiles (x = col, y = row), long ones are planned chunk by chunk
+    bool findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& path);
+
+    // connected pockets of dug out tiles, -1 for solid tiles or outside the grid
+    int getComponent(int row, int col) const;
+    // O(1)ish check before pathing, from may still be solid (a worker stood in the tile it's digging)
+    bool isReachable(sf::Vector2i from, sf::Vector2i to) const;
+
+    // tiles dug out since the last clear (x = col, y = row), workers repair their paths from these
+    const std::vector<sf::Vector2i>& getOpenedTiles() const { return m_openedTiles; }
+    void clearOpenedTiles() { m_openedTiles.clear(); }
+
     sf::Vector2i worldToTile(sf::Vector2f worldPos) const;
 
+    // grid cells (x = col, y = row) the world segment start->end passes through, in order, in bounds only
+    void traverseCells(sf::Vector2f start, sf::Vector2f end, std::vector<sf::Vector2i>& cells) const;
+    // stops at the first solid cell along the segment, false if it only crosses empty space
+    bool raycastFirstSolid(sf::Vector2f start, sf::Vector2f end, sf::Vector2i& hitCell) const;
+
+    // steps from a dug out tile up to the nearest open row 0 tile, shared by every worker heading home
+    int getSurfaceDistance(int row, int col) const;
+    // open neighbour (x = col, y = row) one step closer to the surface, false at the surface or when walled in
+    bool stepTowardSurface(sf::Vector2i tile, sf::Vector2i& next) const;
+
 
 private:
 
+    bool loadTilePalette(const MapConfig& mapConfig);
+    void resetGrid(int cols, float tileSize, float windowWidth, float windowHeight);
+    void generateLayerRows(int firstRow, int rowCount, int cols, std::uint64_t seed, std::vector<std::uint8_t>& layers) const;
+    void appendRows(const std::vector<std::uint8_t>& layers, int rowCount);
+    void streamWorker(int cols, int totalRows, std::uint64_t seed);
+    void stopStreaming();
+    void resizeChunks();
+    void markChunkDirty(int row, int col);
+    void rebuildChunk(int chunkRow, int chunkCol);
+    void appendQuad(sf::VertexArray& vertices, sf::Vector2f pos, float size, const sf::IntRect& texRect, sf::Color color);
+
     sf::Texture m_backgroundTexture;
     sf::Sprite m_backgroundSprite{ m_backgroundTexture };
-	sf::Texture m_crackedOverlayTexture; 
+
+    // layer textures, crack frames and the collectibles sheet all live in this one texture
+    TextureAtlas m_atlas;
+    std::vector<sf::IntRect> m_layerAtlasRects;   // indexed by layer id
+    std::vector<sf::IntRect> m_crackAtlasRects;   // indexed by crack frame
+
+    std::vector<TerrainChunk> m_chunks;
+    int m_chunkRows = 0;
+    int m_chunkCols = 0;
 
     int m_rowsGenerated = 0;      
     float m_tileSize = 0.f;
 
     float m_windowWidth = 0.f;
     float m_windowHeight = 0.f;
+    sf::Vector2f m_gridOffset;      // world position of the top left corner of tile (0, 0)
 
     int m_rows = 0;
     int m_cols = 0;
+    int m_targetRows = 0;
+    std::uint64_t m_worldSeed = 0;
+
+    // streaming generation, everything below is shared with the worker and guarded by m_streamMutex
+    std::thread m_streamThread;
+    std::mutex m_streamMutex;
+    std::condition_variable m_streamCondition;
+    std::deque<GeneratedRowBlock> m_streamReady;
+    int m_streamRequestedRows = 0;
+    int m_streamQueuedRows = 0;
+    bool m_streamStop = false;
 
     std::vector<LayerType> m_layerTypes; 
-    std::vector<Tile> m_tiles;           
+    std::vector<int> m_layerHardness;    // hardness per layer id, kept apart from the textures
+
+    // tile state is kept as parallel arrays indexed by row * m_cols + col
+    std::vector<std::uint8_t> m_tileLayer;     // layer id, EMPTY_TILE_LAYER once dug
+    std::vector<std::uint16_t> m_tileHP;
+    std::vector<std::uint8_t> m_tileCrack;     // crack frame 0-4
+    std::unordered_map<int, sf::Color> m_tileTints; // debug colouring only
+
+    // bit set while a tile is solid, rows padded to whole words so a row starts at row * m_solidWordsPerRow
+    std::vector<std::uint64_t> m_solidBits;
+    int m_solidWordsPerRow = 0;
+
+    // distance field to the surface over dug out tiles, row * m_cols + col. digging only ever
+    // shortens routes so opened tiles are relaxed outwards instead of rebuilding the field
+    std::vector<int> m_surfaceDistance;
+    std::vector<int> m_surfaceQueue;     // scratch for relaxSurfaceDistance, kept to avoid reallocating
+    void relaxSurfaceDistance(int row, int col);
+
+    // chunk graph for long paths, told about every tile that opens up
+    HierarchicalPathfinder m_pathGraph;
+    std::vector<sf::Vector2i> m_openedTiles;
+
+    // connected pockets of dug out tiles, for isReachable
+    TileComponents m_components;
+
+    std::vector<TileDamage> m_pendingDamage;
+    std::vector<std::pair<int, int>> m_damageScratch;   // (tile index, total damage), reused every tick
+    std::vector<int> m_destroyedScratch;
+
     std::vector<bool> m_ladders; 
 
     int m_hoveredIndex = -1;
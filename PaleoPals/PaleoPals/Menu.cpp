@@ -34,6 +34,16 @@ void Menu::initMenu()
     m_quitButton.setOrigin(sf::Vector2f(46, 17));
     m_quitButton.setScale(sf::Vector2f(3, 3));
 
+    // loading bar sits under the buttons while museum assets stream in
+    m_loadingBarBack.setSize(sf::Vector2f(400.f, 16.f));
+    m_loadingBarBack.setOrigin(sf::Vector2f(200.f, 8.f));
+    m_loadingBarBack.setPosition(sf::Vector2f(860, 780));
+    m_loadingBarBack.setFillColor(sf::Color(30, 30, 30, 200));
+    m_loadingBarBack.setOutlineColor(sf::Color(200, 200, 200));
+    m_loadingBarBack.setOutlineThickness(2.f);
+
+    m_loadingBarFill.setPosition(m_loadingBarBack.getPosition() - m_loadingBarBack.getOrigin());
+    m_loadingBarFill.setFillColor(sf::Color(100, 220, 100));
 
 }
 
@@ -41,7 +51,7 @@ void Menu::update(const sf::RenderWindow& window)
 {
     sf::Vector2f mouse = window.mapPixelToCoords(sf::Mouse::getPosition(window));
 
-    if (m_startButton.getGlobalBounds().contains(mouse))
+    if (m_startButton.getGlobalBounds().contains(mouse) && !isLoading())
     {
         m_startButton.setTextureRect(sf::IntRect({ 92,0 }, { 92,34 }));
     }
@@ -50,6 +60,10 @@ void Menu::update(const sf::RenderWindow& window)
         m_startButton.setTextureRect(sf::IntRect({ 0,0 }, { 92,34 }));
     }
 
+    // greyed out until everything is loaded
+    m_startButton.setColor(isLoading() ? sf::Color(120, 120, 120) : sf::Color::White);
+    m_loadingBarFill.setSize(sf::Vector2f(m_loadingBarBack.getSize().x * m_loadingProgress, m_loadingBarBack.getSize().y));
+
     if (m_quitButton.getGlobalBounds().contains(mouse))
     {
         m_quitButton.setTextureRect(sf::IntRect({ 92,0 }, {92,34 }));
@@ -65,13 +79,19 @@ void Menu::draw(sf::RenderWindow& window)
     window.draw(m_backgroundSprite);
     window.draw(m_startButton);
     window.draw(m_quitButton);
+
+    if (isLoading())
+    {
+        window.draw(m_loadingBarBack);
+        window.draw(m_loadingBarFill);
+    }
 }
 
 GameState Menu::handleClick(const sf::RenderWindow& window)
 {
     sf::Vector2f mouse = window.mapPixelToCoords(sf::Mouse::getPosition(window));
 
-    if (m_startButton.getGlobalBounds().contains(mouse))
+    if (m_startButton.getGlobalBounds().contains(mouse) && !isLoading())
     {
         return GameState::Gameplay;
     }
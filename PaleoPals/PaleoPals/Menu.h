@@ -15,6 +15,10 @@ public:
     void draw(sf::RenderWindow& window);
     GameState handleClick(const sf::RenderWindow& window);
 
+    // 0-1, the start button stays locked and a bar is shown until this reaches 1
+    void setLoadingProgress(float progress) { m_loadingProgress = progress; }
+    bool isLoading() const { return m_loadingProgress < 1.f; }
+
 private:
     sf::Texture m_backgroundTexture;
     sf::Sprite m_backgroundSprite{m_backgroundTexture};
@@ -24,5 +28,9 @@ private:
 
     sf::Texture m_quitButtonTexture;
     sf::Sprite m_quitButton{m_quitButtonTexture};
+
+    float m_loadingProgress = 1.f;
+    sf::RectangleShape m_loadingBarBack;
+    sf::RectangleShape m_loadingBarFill;
 };
 #endif
\ No newline at end of file
@@ -4,19 +4,19 @@
 
 Museum::Museum() = default;
 
-bool Museum::loadMuseumFromConfig(const nlohmann::json& data)
+bool Museum::loadMuseumFromConfig(const BuildingConfig& data)
 {
 
-    if (!m_texture.loadFromFile(data["texture"].get<std::string>()))
+    if (!m_texture.loadFromFile(data.texture))
     {
         std::cerr << "Failed to load museum texture" << std::endl;
         return false;
     }
 
-    m_frameWidth = data["frameWidth"].get<int>();
-    m_frameHeight = data["frameHeight"].get<int>();
+    m_frameWidth = data.frameWidth;
+    m_frameHeight = data.frameHeight;
 
-    m_position = sf::Vector2f(data["position"]["x"].get<float>(), data["position"]["y"].get<float>());
+    m_position = data.position;
 
     m_sprite.setTexture(m_texture);
     m_sprite.setTextureRect(sf::IntRect({ 0,0 }, { m_frameWidth,m_frameHeight }));
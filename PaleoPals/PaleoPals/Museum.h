@@ -3,13 +3,13 @@
 #define MUSEUM_H
 
 #include <SFML/Graphics.hpp>
-#include <json.hpp>
+#include "GameConfig.h"
 
 class Museum {
 public:
 	Museum();
 
-	bool loadMuseumFromConfig(const nlohmann::json& data);
+	bool loadMuseumFromConfig(const BuildingConfig& data);
 	void updateMuseumHover(const sf::RenderWindow& window);
 	void drawMuseum(sf::RenderWindow& window);
 
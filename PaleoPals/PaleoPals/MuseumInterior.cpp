@@ -1,4 +1,5 @@
 #include "MuseumInterior.h"
+#include "AssetCache.h"
 #include "constants.h"
 #include <iostream>
 #include <algorithm>
@@ -9,7 +10,8 @@ MuseumInterior::MuseumInterior()
       m_backSprite(m_backTex),
 	  m_interiorSprite(m_interiorTex),
 	  m_skinToggleButton(m_skinToggleTex),
-	  m_dinoNameText(m_font)
+	  m_font(AssetCache::get().getFont("ASSETS/FONTS/Jersey20-Regular.ttf")),
+	  m_dinoNameText(*m_font)
 {
 
     if (!m_interiorTex.loadFromFile("ASSETS/IMAGES/Screens/Museum_Interior.png"))
@@ -70,67 +72,176 @@ MuseumInterior::MuseumInterior()
 	m_skinToggleButton.setTextureRect(sf::IntRect({ 0, 0 }, { 241, 64 }));
     m_skinToggleButton.setScale(sf::Vector2f(0.5f, 0.5f));
    
-    if (!m_font.openFromFile("ASSETS/FONTS/Jersey20-Regular.ttf"))
-    {
-		std::cout << "MuseumInterior: failed to load font\n";
-    }
-
-	m_dinoNameText.setFont(m_font);
+	m_dinoNameText.setFont(*m_font);
 	m_dinoNameText.setCharacterSize(24);
 	m_dinoNameText.setFillColor(sf::Color::White);
 	m_dinoNameText.setStyle(sf::Text::Bold);
 
 }
 
-bool MuseumInterior::loadAssets(const std::vector<DinosaurData>& dinoData)
+bool MuseumInterior::loadAssets(const std::vector<DinosaurData>& dinoData, AssetLoader& loader)
 {
+    m_loader = &loader;
     m_dinos.clear();
     m_dinos.reserve(dinoData.size());
+    m_residentBytes = 0;
 
+    // only paths for now, textures are loaded when a species is first looked at
     for (const auto& data : dinoData)
     {
         auto display = std::make_unique<DinoDisplay>();
         display->name = data.name;
-
-        if (!display->backgroundTex.loadFromFile(data.backgroundTexture))
-        {
-            std::cerr << "MuseumInterior: failed to load background for " << data.name << "\n";
-        }
-        else
-        {
-            display->backgroundSprite = sf::Sprite(display->backgroundTex);
-        }
+        display->backgroundPath = data.backgroundTexture;
+        display->skinPath = data.skinTexture;
+        display->hasSkin = !data.skinTexture.empty();
 
         for (const auto& piece : data.pieces)
         {
             int idx = pieceIdToIndex(piece.id);
             if (idx < 0 || idx > 3) continue;
 
-            if (!display->pieceTex[idx].loadFromFile(piece.texturePath))
+            display->piecePaths[idx] = piece.texturePath;
+        }
+
+        m_dinos.push_back(std::move(display));
+    }
+
+    // first species the museum opens on is ready before gameplay starts
+    if (!m_dinos.empty())
+    {
+        viewDino(0);
+    }
+
+    std::cout << "MuseumInterior: " << m_dinos.size() << " dinosaur displays\n";
+    return !m_dinos.empty();
+}
+
+void MuseumInterior::viewDino(int index)
+{
+    if (m_dinos.empty()) return;
+
+    int count = static_cast<int>(m_dinos.size());
+    m_currentDinoIndex = index;
+    m_dinos[index]->lastViewed = ++m_viewCounter;
+
+    requestResident(index);
+
+    // arrow targets are fetched ahead so stepping left or right doesn't show an empty frame
+    requestResident((index + 1) % count);
+    requestResident((index - 1 + count) % count);
+
+    enforceTextureBudget();
+}
+
+void MuseumInterior::requestResident(int index)
+{
+    DinoDisplay* target = m_dinos[index].get();
+
+    if (target->resident || target->pendingUploads > 0 || !m_loader)
+        return;
+
+    // displays are heap allocated so this pointer stays good while the loader fills them in
+    auto queue = [this, target](const std::string& path, sf::Texture& texture, std::function<void(bool)> onLoaded)
+        {
+            if (path.empty()) return;
+
+            ++target->pendingUploads;
+
+            m_loader->queueTexture(path, texture, [this, target, &texture, onLoaded](bool loaded)
+                {
+                    if (loaded)
+                    {
+                        std::size_t bytes = static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4;
+                        target->residentBytes += bytes;
+                        m_residentBytes += bytes;
+                        onLoaded(loaded);
+                    }
+
+                    if (--target->pendingUploads == 0)
+                    {
+                        target->resident = true;
+                        enforceTextureBudget();
+                    }
+                });
+        };
+
+    queue(target->backgroundPath, target->backgroundTex, [target](bool)
+        {
+            target->backgroundSprite = sf::Sprite(target->backgroundTex);
+        });
+
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        queue(target->piecePaths[idx], target->pieceTex[idx], [target, idx](bool)
             {
-                std::cerr << "MuseumInterior: failed to load piece " << piece.id
-                    << " for " << data.name << "\n";
-            }
-            else
+                target->pieceSprite[idx] = sf::Sprite(target->pieceTex[idx]);
+            });
+    }
+
+    queue(target->skinPath, target->skinTex, [target](bool)
+        {
+            target->skinSprite = sf::Sprite(target->skinTex);
+        });
+
+    if (target->pendingUploads == 0)
+    {
+        // nothing to load at all
+        target->resident = true;
+    }
+}
+
+void MuseumInterior::evict(int index)
+{
+    DinoDisplay& dino = *m_dinos[index];
+
+    // sprites keep pointing at these objects, an empty texture just draws nothing
+    dino.backgroundTex = sf::Texture();
+    dino.skinTex = sf::Texture();
+    for (sf::Texture& piece : dino.pieceTex)
+    {
+        piece = sf::Texture();
+    }
+
+    m_residentBytes -= dino.residentBytes;
+    dino.residentBytes = 0;
+    dino.resident = false;
+
+    std::cout << "MuseumInterior: evicted " << dino.name << "\n";
+}
+
+void MuseumInterior::enforceTextureBudget()
+{
+    if (m_dinos.empty()) return;
+
+    int count = static_cast<int>(m_dinos.size());
+    int next = (m_currentDinoIndex + 1) % count;
+    int prev = (m_currentDinoIndex - 1 + count) % count;
+
+    while (m_residentBytes > m_textureBudgetBytes)
+    {
+        // least recently viewed species that isn't on screen or one arrow press away
+        int oldest = -1;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const DinoDisplay& dino = *m_dinos[i];
+
+            if (!dino.resident || dino.residentBytes == 0) continue;
+            if (i == m_currentDinoIndex || i == next || i == prev) continue;
+
+            if (oldest < 0 || dino.lastViewed < m_dinos[oldest]->lastViewed)
             {
-                display->pieceSprite[idx] = sf::Sprite(display->pieceTex[idx]);
+                oldest = i;
             }
         }
-        
-        if (!data.skinTexture.empty())
+
+        if (oldest < 0)
         {
-            if (display->skinTex.loadFromFile(data.skinTexture))
-            {
-                display->skinSprite = sf::Sprite(display->skinTex);
-                display->hasSkin = true;
-            }
+            return;     // everything left is in use, let the budget overrun for now
         }
 
-        m_dinos.push_back(std::move(display));
+        evict(oldest);
     }
-
-    std::cout << "MuseumInterior: loaded " << m_dinos.size() << " dinosaur displays\n";
-    return !m_dinos.empty();
 }
 
 void MuseumInterior::onFossilCollected(const std::string& dinoName, const std::string& pieceId)
@@ -154,6 +265,8 @@ void MuseumInterior::open()
     m_open = true;
     if (m_currentDinoIndex >= static_cast<int>(m_dinos.size()))
         m_currentDinoIndex = 0;
+
+    viewDino(m_currentDinoIndex);
 }
 
 void MuseumInterior::close()
@@ -175,13 +288,13 @@ bool MuseumInterior::handleClick(const sf::Vector2f& screenPos)
     {
         if (containsPoint(m_leftArrow, screenPos))
         {
-            m_currentDinoIndex = (m_currentDinoIndex - 1 + static_cast<int>(m_dinos.size()))
-                % static_cast<int>(m_dinos.size());
+            viewDino((m_currentDinoIndex - 1 + static_cast<int>(m_dinos.size()))
+                % static_cast<int>(m_dinos.size()));
         }
         else if (containsPoint(m_rightArrow, screenPos))
         {
-            m_currentDinoIndex = (m_currentDinoIndex + 1)
-                % static_cast<int>(m_dinos.size());
+            viewDino((m_currentDinoIndex + 1)
+                % static_cast<int>(m_dinos.size()));
         }
     }
 
@@ -322,7 +435,7 @@ void MuseumInterior::draw(sf::RenderWindow& window)
             window.draw(indicator);
         }
 
-        if (dino.showSkin && dino.hasSkin)
+        if (dino.showSkin && dino.hasSkin && dino.skinTex.getSize().x > 0)
         {
             sf::Vector2u skinSize = dino.skinTex.getSize();
 
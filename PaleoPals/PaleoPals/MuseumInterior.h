@@ -7,14 +7,23 @@
 #include <string>
 #include <memory>
 #include <array>
+#include <cstdint>
 #include "Fossil.h"
+#include "AssetLoader.h"
+
+// species textures only stay loaded while they fit in this, least recently viewed go first
+const std::size_t MUSEUM_TEXTURE_BUDGET_BYTES = 64u * 1024u * 1024u;
 
 class MuseumInterior
 {
 public:
     MuseumInterior();
 
-    bool loadAssets(const std::vector<DinosaurData>& dinoData);
+    // displays are created straight away, a species' textures are only loaded once it is viewed
+    bool loadAssets(const std::vector<DinosaurData>& dinoData, AssetLoader& loader);
+
+    void setTextureBudget(std::size_t bytes) { m_textureBudgetBytes = bytes; enforceTextureBudget(); }
+    std::size_t getResidentTextureBytes() const { return m_residentBytes; }
 
     void onFossilCollected(const std::string& dinoName, const std::string& pieceId);
 
@@ -44,12 +53,29 @@ private:
     bool containsPoint(const sf::Sprite& sprite, const sf::Vector2f& pt) const;
     int  pieceIdToIndex(const std::string& pieceId) const;
 
+    // makes index current, loads it and both arrow neighbours, then evicts down to the budget
+    void viewDino(int index);
+    void requestResident(int index);
+    void evict(int index);
+    void enforceTextureBudget();
+
     bool m_open = false;
     int  m_currentDinoIndex = 0;
 
     struct DinoDisplay
     {
         std::string name;
+
+        // where the textures come from, kept so an evicted species can be loaded again
+        std::string backgroundPath;
+        std::string skinPath;
+        std::array<std::string, 4> piecePaths;
+
+        bool resident = false;          // every texture uploaded
+        int pendingUploads = 0;         // non zero while loading
+        std::size_t residentBytes = 0;
+        std::uint64_t lastViewed = 0;
+
         sf::Texture backgroundTex;
         sf::Sprite  backgroundSprite;
         sf::Texture skinTex;
@@ -74,10 +100,15 @@ private:
     };
 
 
-    sf::Font m_font;
+    std::shared_ptr<sf::Font> m_font;
     sf::Text m_dinoNameText;
 
     std::vector<std::unique_ptr<DinoDisplay>> m_dinos;
+
+    AssetLoader* m_loader = nullptr;
+    std::size_t m_textureBudgetBytes = MUSEUM_TEXTURE_BUDGET_BYTES;
+    std::size_t m_residentBytes = 0;
+    std::uint64_t m_viewCounter = 0;
    
     sf::Texture m_interiorTex;
     sf::Sprite  m_interiorSprite{ m_interiorTex };
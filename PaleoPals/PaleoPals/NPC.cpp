@@ -4,113 +4,68 @@
 #include <random>
 #include <queue>
 #include <algorithm>
+#include <array>
 
-NPC::NPC()
+NPC::NPC(sf::Vector2f spawnPosition)
+	: m_position(spawnPosition)
 {
+}
 
-	if (!m_texture.loadFromFile("ASSETS/IMAGES/Sprites/Characters/paleontologist_walk.png"))
-	{
-		std::cerr << "failed to load npc sprite \n";
-	}
-	else
+NPC::~NPC()
+{
+	if (m_pathService && m_fossilTicket != NO_PATH_TICKET)
 	{
-		std::cout << "npc loaded from file \n";
+		m_pathService->cancel(m_fossilTicket);
 	}
-
-	m_sprite.setTexture(m_texture);
-	m_sprite.setTextureRect(sf::IntRect({ 0,0 }, { m_frameWidth,m_frameHeight }));
-	m_sprite.setOrigin(sf::Vector2f(m_frameWidth / 2.0f, m_frameHeight));
-	m_sprite.setScale(sf::Vector2f(0.12f, 0.12f));
-	m_sprite.setColor(sf::Color::Cyan);
-
-	m_sprite.setPosition(sf::Vector2f(WINDOW_X / 2.0f - 150.0f, WINDOW_Y / 2.0f - 40.0f));	
-
 }
 
-void NPC::updateNPC(sf::Time dt, Map& map)
+void NPC::resetProgress()
 {
-	if (m_root)
+	if (m_pathService && m_fossilTicket != NO_PATH_TICKET)
 	{
-		m_root->tick(dt.asSeconds());
+		m_pathService->cancel(m_fossilTicket);
 	}
-	updateNPCAnimation(dt);
-}
 
-void NPC::drawNPC(sf::RenderWindow& window)
-{
+	m_fossilTicket = NO_PATH_TICKET;
+	m_fossilPlanWaiting = false;
+	m_fossilPlanner.reset();
 
-	window.draw(m_sprite);
+	m_fossilPath.clear();
+	m_fossilPath.shrink_to_fit();
+	m_fossilIndex = 0;
 
+	m_wandering = false;
 }
 
-void NPC::updateReturn(sf::Time dt, Map& map)
+void NPC::updateNPC(sf::Time dt, Map& map)
 {
-	if (m_returnIndex >= m_returnPath.size()) {
-		m_state = NPCState::WANDERTHESURFACE;
-		m_returningToSurface = false;
-		m_returnPath.clear();
-		m_returnIndex = 0;
-		return;
-	}
-
-	sf::Vector2i targetTile = m_returnPath[m_returnIndex];
-	sf::Vector2f targetPos = tileToWorld(targetTile, map);
-	sf::Vector2f pos = m_sprite.getPosition();
-	sf::Vector2f dir = targetPos - pos;
-
-	float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-
-	if (dist < 4.f) {
-		m_returnIndex++;
-		return;
+	if (m_wandering)
+	{
+		updateSurfaceWandering(dt, map);
 	}
 
-	dir /= dist;
-	m_velocity = dir * m_moveSpeed;
-	m_sprite.move(m_velocity * dt.asSeconds());
-	m_facingRight = (dir.x >= 0);
+	updateNPCAnimation(dt);
 }
 
-void NPC::updateMining(sf::Time dt, Map& map)
+bool NPC::walkToTile(sf::Vector2i tile, float dt, Map& map)
 {
-	//normal mining
-	if (m_miningIndex >= m_miningPath.size())
-	{
-		m_returningToSurface = true;
-		return;
-	}
-
-	sf::Vector2i targetTile = m_miningPath[m_miningIndex];
-	sf::Vector2f targetPos = tileToWorld(targetTile, map);
-	sf::Vector2f pos = m_sprite.getPosition();
-	sf::Vector2f dir = targetPos - pos;
+	sf::Vector2f targetPos = map.tileToWorld(tile);
+	sf::Vector2f dir = targetPos - m_position;
 
 	float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
 
-	// If tile is still solid damage it over time
-	if (map.getTileHardness(targetTile.y, targetTile.x) > 0)
-	{
-		npcMiningDamageCooldown -= dt.asSeconds();
-		if (npcMiningDamageCooldown <= 0.f)
-		{
-			mineTile(map, targetTile);
-			npcMiningDamageCooldown = npcMiningTickDelay;
-		}
-		return; // stay until tile breaks
-	}
-
-	// Tile is broken move toward it
 	if (dist < 4.f)
 	{
-		m_miningIndex++;
-		return;
+		return true;
 	}
 
 	dir /= dist;
 	m_velocity = dir * m_moveSpeed;
-	m_sprite.move(m_velocity * dt.asSeconds());
+	m_position += m_velocity * dt;
 	m_facingRight = (dir.x >= 0);
-}	
+
+	return false;
+}
 
 void NPC::mineTile(Map& map, sf::Vector2i tile)
 {
@@ -119,47 +74,36 @@ void NPC::mineTile(Map& map, sf::Vector2i tile)
 		return;
 	}
 
-	if (map.getTileHardness(tile.y, tile.x) > 0)
+	if (map.isSolid(tile.y, tile.x))
 	{
 		map.damageTile(tile.y, tile.x, m_npcMiningDamage);
 	}
 }
 
-void NPC::generateMiningPath(Map& map)
+int NPC::planMiningPath(Map& map, sf::Vector2i start, sf::Vector2i* path, int maxTiles) const
 {
-	m_miningPath.clear();	// remove old path 
-	m_returnPath.clear();	
-
-	m_miningIndex = 0;	// start on index 0
-	m_returnIndex = 0;
-
-	m_returningToSurface = false;
-
-	sf::Vector2i start = worldToTile(m_sprite.getPosition(), map);	// convert npc world coords to grid coords
-	m_miningStartTile = start;
+	int count = 0;
 
 	std::vector<sf::Vector2i> stack;
+	stack.reserve(static_cast<size_t>(maxTiles) * 4);
 	stack.push_back(start);	// push start pos onto S/Q
 
-	std::vector<std::vector<bool>> visited(map.getRowCount(), std::vector<bool>(map.getColumnCount(), false));	// array matching map size, tells me whether tile was visited
-
 	auto inBounds = [&](sf::Vector2i t)		// returns true if t is inside map 
 		{
 			return t.x >= 0 && t.x < map.getColumnCount() && t.y >= 0 && t.y < map.getRowCount();
 		};
 
-	auto neighbours = [&](sf::Vector2i t)	// returns a tiles 4 neighbors (R,L.D,U)
+	// a trip is only a handful of tiles, so what's already in the path is the visited set
+	auto visited = [&](sf::Vector2i t)
 		{
-			return std::vector<sf::Vector2i>{
-				{t.x + 1, t.y},
-				{ t.x - 1, t.y },
-				{ t.x, t.y + 1 },
-				{ t.x, t.y - 1 }};
+			return std::find(path, path + count, t) != path + count;
 		};
+
+	static std::mt19937 gen(std::random_device{}());
 	
 	while (!stack.empty())
 	{
-		if (m_miningPath.size() >= 10) // depth of search is 20
+		if (count >= maxTiles) // depth of search
 		{
 			break;
 		}
@@ -170,292 +114,168 @@ void NPC::generateMiningPath(Map& map)
 		{
 			currentTile = stack.back();
 			stack.pop_back();
-			//std::cout << "dfs used \n"; 
 		}
 
 		if (!inBounds(currentTile)) continue;		// not ibounds = skip
 
-		if (visited[currentTile.y][currentTile.x]) continue;	// already processed = skip 
-
-		visited[currentTile.y][currentTile.x] = true;	// if processed mark visited
+		if (visited(currentTile)) continue;	// already processed = skip 
 
-		m_miningPath.push_back(currentTile);	// Add tile to path
+		path[count++] = currentTile;	// Add tile to path
 
-		//map.colourTile(currentTile.y, currentTile.x, sf::Color::Red);	// Colour tile red
-
-		auto neigh = neighbours(currentTile);
-		std::shuffle(neigh.begin(), neigh.end(), std::mt19937(std::random_device{}()));	// sshuffe to make pathing feel more organic 
+		// a tiles 4 neighbors (R,L.D,U)
+		std::array<sf::Vector2i, 4> neigh = { {
+			{ currentTile.x + 1, currentTile.y },
+			{ currentTile.x - 1, currentTile.y },
+			{ currentTile.x, currentTile.y + 1 },
+			{ currentTile.x, currentTile.y - 1 } } };
+		std::shuffle(neigh.begin(), neigh.end(), gen);	// sshuffe to make pathing feel more organic 
 
 		for (auto& n : neigh)	// Explore neighbours
 		{
-			if (inBounds(n) && !visited[n.y][n.x])
+			if (inBounds(n) && !visited(n))
 				stack.push_back(n);
 		}
 	}
 
-	std::cout << "NPC mining path generated: " << m_miningPath.size() << " tiles\n";
+	return count;
 }
 
-void NPC::generateReturnPath(Map& map)
+void NPC::generateFossilPath(Map& map, sf::Vector2i goal)
 {
-	m_returnPath.clear();
-	m_returnIndex = 0;
-
-	sf::Vector2i start = worldToTile(m_sprite.getPosition(), map);
-	sf::Vector2i goal = m_miningStartTile;
-
-	int rows = map.getRowCount();
-	int cols = map.getColumnCount();
-
-	auto inBounds = [&](sf::Vector2i t)		// check if in bounds
-		{
-			return t.x >= 0 && t.x < map.getColumnCount() && t.y >= 0 && t.y < map.getRowCount();
-		};
-
-
-	auto isWalkable = [&](sf::Vector2i t)	// only walk on already broken tiles
-		{
-			if (!inBounds(t))
-			{
-				return false;
-			}
-
-			return map.getTileHardness(t.y, t.x) <= 0;
-		};
-
+	if (m_pathService && m_fossilTicket != NO_PATH_TICKET)
+	{
+		m_pathService->cancel(m_fossilTicket);
+	}
 
-	auto neighbours = [&](sf::Vector2i t)		// return neighbours in 4 directions
-		{
-			return std::vector<sf::Vector2i>{
-				{t.x + 1, t.y},
-				{ t.x - 1, t.y },
-				{ t.x, t.y + 1 },
-				{ t.x, t.y - 1 }};
-		};
+	m_fossilTicket = NO_PATH_TICKET;
+	m_fossilPlanWaiting = false;
+	m_fossilGoal = goal;
+	m_fossilIndex = 0;
+	m_fossilPath.clear();
 
-	std::queue<sf::Vector2i> queue;
-	std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
-	std::vector<std::vector<sf::Vector2i>> parent(rows, std::vector<sf::Vector2i>(cols, sf::Vector2i(-1, -1)));
+	sf::Vector2i start = map.worldToTile(m_position);
 
-	if (!inBounds(start) || !inBounds(goal))
+	if (!map.isReachable(start, goal))
 	{
+		m_fossilPlanner.reset();
+		m_fossilPath.clear();
 		return;
 	}
 
-	queue.push(start);
-	visited[start.y][start.x] = true;
 	bool found = false;
 
-	while (!queue.empty())
+	// nearby targets keep a D* Lite search alive so digging can shorten the path later,
+	// long trips are queued with the path service and picked up in updateFossilPath
+	if (std::abs(goal.x - start.x) + std::abs(goal.y - start.y) <= LOCAL_REPLAN_RANGE)
 	{
-		sf::Vector2i current = queue.front();
-		queue.pop();
+		if (m_pathService && !m_pathService->reserveLocalSearch())
+		{
+			m_fossilPlanWaiting = true;
+			return;
+		}
 
-		if (current == goal)
+		if (!m_fossilPlanner)
 		{
-			found = true;
-			break;
+			m_fossilPlanner = std::make_unique<DStarLite>();
 		}
 
-		for (sf::Vector2i next : neighbours(current))
+		found = m_fossilPlanner->plan(map.getSolidView(), start, goal) && m_fossilPlanner->extractPath(map.getSolidView(), m_fossilPath);
+
+		if (m_pathService)
 		{
-			if (!isWalkable(next))
-			{
-				continue;
-			}
-
-			if (visited[next.y][next.x])
-			{
-				continue;
-			}
-
-			visited[next.y][next.x] = true;
-			parent[next.y][next.x] = current;
-			queue.push(next);
+			m_pathService->chargeLocalSearch(m_fossilPlanner->getLastExpanded());
 		}
 	}
 
+	// too far, or the way round leaves the rows D* Lite searches, so go the long way
 	if (!found)
 	{
-		std::cout << "npc cant find return path \n";
-		return;
-	}
-
-	sf::Vector2i current = goal;
+		m_fossilPlanner.reset();
 
-	while (current != start)
-	{
-		m_returnPath.push_back(current);
-		current = parent[current.y][current.x];
+		if (m_pathService)
+		{
+			m_fossilTicket = m_pathService->request(start, goal);
+			return;
+		}
 
+		found = map.findPath(start, goal, m_fossilPath);
 	}
 
-		std::reverse(m_returnPath.begin(), m_returnPath.end());
-
-		std::cout << "return path generated \n";
-	
+	if (!found)
+	{
+		m_fossilPath.clear();
+		std::cout << "npc cant find fossil path \n";
+	}
 }
 
-void NPC::generateFossilPath(Map& map, sf::Vector2i goal)
+int NPC::onTilesOpened(Map& map, const std::vector<sf::Vector2i>& opened)
 {
-	m_fossilPath.clear();
-	m_fossilIndex = 0;
-
-	sf::Vector2i start = worldToTile(m_sprite.getPosition(), map);
+	int expanded = -1;
 
-	auto inBounds = [&](sf::Vector2i t)		// check if in bounds
-		{
-			return t.x >= 0 && t.x < map.getColumnCount() &&
-				   t.y >= 0 && t.y < map.getRowCount();
-		};
-
-	auto isWalkable = [&](sf::Vector2i t)	// only walk on already broken tiles
-		{
-			if (!inBounds(t))
-			{
-				return false;
-			}
-			return map.getTileHardness(t.y, t.x) <= 0;
-		};
-
-	auto heuristic = [&](sf::Vector2i a, sf::Vector2i b)	// Manhattan distance heuristic  
-		{
-			return std::abs(a.x - b.x) + std::abs(a.y - b.y);
-		};
-
-
-	struct Node
+	// tiles only ever open, so old paths still work, they just might not be the shortest any more.
+	// digging nowhere near what the search has looked at can't change it, so that's skipped
+	if (m_fossilPlanner && !m_fossilPath.empty() && m_fossilPlanner->isAffectedBy(opened))
 	{
-		sf::Vector2i pos;
-		int gCost;
-		int hCost;
-		sf::Vector2i parent;
-	};
+		SolidGridView grid = map.getSolidView();
 
-
-	struct Vector2iCompare
-	{
-		bool operator()(const sf::Vector2i& a, const sf::Vector2i& b) const
+		if (m_fossilPlanner->repair(grid, map.worldToTile(m_position), opened) && m_fossilPlanner->extractPath(grid, m_fossilPath))
 		{
-			if (a.y == b.y) return a.x < b.x;
-			return a.y < b.y;
-		}
-	};
-
-	struct NodeCompare
-	{
-		bool operator()(const std::pair<int, Node>& a, const std::pair<int, Node>& b) const
-		{
-			return a.first > b.first; // min-heap based on f score
+			m_fossilIndex = 0;
 		}
-	};
-
-	std::priority_queue<std::pair<int, Node>, std::vector<std::pair<int, Node>>, NodeCompare>open;
 
-	// tile position comparison lambda for map 
-	std::map<sf::Vector2i, Node, Vector2iCompare> allNodes;
+		expanded = m_fossilPlanner->getLastExpanded();
+	}
 
-	open.push({ heuristic(start, goal), { start, 0, heuristic(start, goal), sf::Vector2i(-1, -1) } });
+	return expanded;
+}
 
-	allNodes[start] = { start, 0, heuristic(start, goal), sf::Vector2i(-1, -1) };
+void NPC::updateFossilPath(sf::Time dt, Map& map)
+{
+	if (m_fossilPlanWaiting)
+	{
+		generateFossilPath(map, m_fossilGoal);
 
-	bool found = false;
+		if (m_fossilPlanWaiting)
+			return;
+	}
 
-	while (!open.empty())
+	// stand still until the service gets round to us
+	if (m_fossilTicket != NO_PATH_TICKET)
 	{
-		auto [f, current] = open.top();
+		PathStatus status = m_pathService->poll(m_fossilTicket, m_fossilPath);
 
-		open.pop();
+		if (status == PathStatus::Pending)
+			return;
 
-		if(current.pos == goal)
-		{
-			found = true;
-			break;
-		}
-
-		std::vector<sf::Vector2i> neighbours = {
-			{current.pos.x + 1, current.pos.y},
-			{current.pos.x - 1, current.pos.y},
-			{current.pos.x, current.pos.y + 1},
-			{current.pos.x, current.pos.y - 1}
-		};
+		m_fossilTicket = NO_PATH_TICKET;
+		m_fossilIndex = 0;
 
-		for (auto& n : neighbours)
+		if (status == PathStatus::Failed)
 		{
-			if (!isWalkable(n))
-			{
-				continue; 
-			}
-
-			int g = allNodes[current.pos].gCost + 1;
-			int h = heuristic(n, goal);
-			int f = g + h;
-
-			if(!allNodes.count(n)|| g<allNodes[n].gCost)
-			{
-				allNodes[n] = { n, g, h, current.pos };
-				open.push({ f, allNodes[n] });
-			}
+			std::cout << "npc cant find fossil path \n";
 		}
 	}
 
-	if (!found)
-	{
-		std::cout << "npc cant find fossil path \n";
-		return;
-	}
-
-	// Reconstruct path
-
-	sf::Vector2i current = goal;
-	
-	while (current != start)
-	{
-		m_fossilPath.push_back(current);
-		current = allNodes[current].parent;
-	}
-
-	std::reverse(m_fossilPath.begin(), m_fossilPath.end());
-
-	std::cout << "fossil path generated: " << m_fossilPath.size() << " tiles " << std::endl;
-}
-
-void NPC::updateFossilPath(sf::Time dt, Map& map)
-{
 	if (m_fossilIndex >= m_fossilPath.size())
 	{
 		// Finished fossil path
 		m_fossilPath.clear();
+		m_fossilPlanner.reset();
 		m_fossilIndex = 0;
 		return;
 	}
 
-	sf::Vector2i targetTile = m_fossilPath[m_fossilIndex];
-	sf::Vector2f targetPos = tileToWorld(targetTile, map);
-	sf::Vector2f pos = m_sprite.getPosition();
-	sf::Vector2f dir = targetPos - pos;
-
-	float dist = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-
-	if (dist < 4.f)
+	if (walkToTile(m_fossilPath[m_fossilIndex], dt.asSeconds(), map))
 	{
 		m_fossilIndex++;
 
 		if (m_fossilIndex >= m_fossilPath.size())
 		{
 			m_fossilPath.clear();
+			m_fossilPlanner.reset();
 			m_fossilIndex = 0;
 		}
-
-		return;
 	}
-
-	dir /= dist;
-	m_velocity = dir * m_moveSpeed;
-	m_sprite.move(m_velocity * dt.asSeconds());
-	m_facingRight = (dir.x >= 0);
-
-	std::cout << "NPC moving towards fossil tile " << targetTile.x << "," << targetTile.y << " index " << m_fossilIndex << "/" << m_fossilPath.size() << std::endl;
 }
 
 void NPC::updateSurfaceWandering(sf::Time dt, Map& map)
@@ -465,11 +285,11 @@ void NPC::updateSurfaceWandering(sf::Time dt, Map& map)
 	int cols = map.getColumnCount();
 	int rows = map.getRowCount();
 
-	// same offset logic as Player
-	float offsetX = (WINDOW_X - cols * tileSize) / 2.0f;
-	float offsetY = WINDOW_Y / 2.0f;
+	sf::Vector2f gridOffset = map.getGridOffset();
+	float offsetX = gridOffset.x;
+	float offsetY = gridOffset.y;
 
-	sf::Vector2f pos = m_sprite.getPosition();
+	sf::Vector2f pos = m_position;
 
 	// horizontal wandering: move left/right
 	if (m_facingRight)
@@ -503,7 +323,7 @@ void NPC::updateSurfaceWandering(sf::Time dt, Map& map)
 	float surfaceY = offsetY + tileSize * 0.0f; // row 0
 	pos.y = surfaceY;
 
-	m_sprite.setPosition(pos);
+	m_position = pos;
 }
 
 void NPC::updateNPCAnimation(sf::Time dt)
@@ -528,41 +348,4 @@ void NPC::setNPCFrames(int frame)
 	}
 
 	m_currentFrame = frame;
-
-	if (m_texture.getSize().x == 0 || m_texture.getSize().y == 0)
-	{
-		return;
-	}
-
-	int xOffset = frame * m_frameWidth;
-	m_sprite.setTextureRect(sf::IntRect({ xOffset, 0 }, { m_frameWidth, m_frameHeight }));
-
-	sf::Vector2f scale = m_sprite.getScale();
-	scale.x = m_facingRight ? std::abs(scale.x) : -std::abs(scale.x);
-	m_sprite.setScale(scale);
-
-}
-
-sf::Vector2i NPC::worldToTile(sf::Vector2f pos, Map& map)
-{
-	float tileSize = map.getTileSize();
-	float offsetX = (WINDOW_X - map.getColumnCount() * tileSize) / 2.0f;
-	float offsetY = WINDOW_Y / 2.0f;
-
-	int col = static_cast<int>((pos.x - offsetX) / tileSize);
-	int row = static_cast<int>((pos.y - offsetY) / tileSize);
-
-	return sf::Vector2i(col, row);
 }
-
-sf::Vector2f NPC::tileToWorld(sf::Vector2i tile, Map& map)
-{
-	float tileSize = map.getTileSize();
-	float offsetX = (WINDOW_X - map.getColumnCount() * tileSize) / 2.0f;
-	float offsetY = WINDOW_Y / 2.0f;
-
-	float x = tile.x * tileSize + offsetX + tileSize / 2.f;
-	float y = tile.y * tileSize + offsetY + tileSize / 2.f;
-
-	return sf::Vector2f(x, y);
-}
\ No newline at end of file
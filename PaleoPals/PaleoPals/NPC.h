@@ -4,70 +4,76 @@
 
 #include <SFML/Graphics.hpp>
 #include "constants.h"
+#include <memory>
 #include "Map.h"
-#include "BTNode.h"
-#include "BTSelectorNode.h"
-#include "BTSequenceNode.h"
-#include "BTWanderSurfaceNode.h"
-#include "BTMiningNode.h"
-#include "BTReturnToSurfaceNode.h"
-#include "BTCollectFossilNode.h"
-
-enum class NPCState
-{
-	WANDERTHESURFACE,
-	MINING,
-	SEARCHING
-};
+#include "DStarLite.h"
+#include "PathService.h"
+
+// fossils closer than this many tiles get a path that repairs itself as tiles open
+const int LOCAL_REPLAN_RANGE = 48;
 
 class NPC
 {
 public:
-	NPC();
+	explicit NPC(sf::Vector2f spawnPosition);
+    ~NPC();
 
-    void setRoot(BTNode* root) { m_root = root; }
-    BTNode* getRoot() const { return m_root; }
+    // long searches are queued here instead of run inside the tick
+    void setPathService(PathService* service) { m_pathService = service; }
+    PathTicket getFossilTicket() const { return m_fossilTicket; }
+    // a fossil path is being walked, searched for or waiting on budget
+    bool hasFossilRoute() const { return !m_fossilPath.empty() || m_fossilTicket != NO_PATH_TICKET || m_fossilPlanWaiting; }
 
+    // drops the fossil path and planner, used when workers switch between the tree and task scripts
+    void resetProgress();
 
+    // behaviour is run by WorkerManager's tree or task scripts, which keep their own progress.
+    // this only animates and walks the surface
     void updateNPC(sf::Time dt, Map& map);
-	void drawNPC(sf::RenderWindow& window);
-    void updateReturn(sf::Time dt, Map& map);
 
-    std::vector<sf::Vector2i> m_miningPath;   // DFS result
-    sf::Vector2i m_miningStartTile;     // npc rememberrs where it starts 
-    std::vector<sf::Vector2i> m_returnPath;
-	std::vector<sf::Vector2i> m_fossilPath; // path to fossil (for Astar)
+	std::vector<sf::Vector2i> m_fossilPath; // path to fossil (for Astar), kept here so digging can repair it
 	int m_fossilIndex = 0;  
 
-    int m_miningIndex = 0;
-    int m_returnIndex = 0;  
-
-    float npcMiningDamageCooldown = 0.0f;
     float npcMiningTickDelay = 0.12f;
     int m_npcMiningDamage = 1;
 
     bool m_useDFS = true;
-    bool m_returningToSurface = false; 
+    bool m_wandering = false;   // set by the wander node, walks every frame even while its tree sleeps
 
-    void updateMining(sf::Time dt, Map& map);
     void mineTile(Map& map, sf::Vector2i tile);
-    void generateMiningPath(Map& map);  //DFS
-    void generateReturnPath(Map& map);
-    void generateFossilPath(Map& map, sf::Vector2i goal);   // Astar
+    // writes up to maxTiles of a random DFS dig from start into path, returns how many
+    int planMiningPath(Map& map, sf::Vector2i start, sf::Vector2i* path, int maxTiles) const;
+    // one step toward the centre of tile, true once it's close enough to count as there
+    bool walkToTile(sf::Vector2i tile, float dt, Map& map);
+    void generateFossilPath(Map& map, sf::Vector2i goal);   // D* Lite up close, HPA* for long trips
+    // patches the fossil path for newly dug tiles, returns nodes re-expanded or -1 if nothing needed it
+    int onTilesOpened(Map& map, const std::vector<sf::Vector2i>& opened);
 	void updateFossilPath(sf::Time dt, Map& map);
     void updateSurfaceWandering(sf::Time dt, Map& map);
 
-    sf::Vector2i worldToTile(sf::Vector2f pos, Map& map);
-    sf::Vector2f tileToWorld(sf::Vector2i tile, Map& map);
-	sf::Vector2f getNPCPosition() const { return m_sprite.getPosition(); }
+	sf::Vector2f getNPCPosition() const { return m_position; }
+
+    // what WorkerManager needs to batch every npc into one draw
+    int getFrame() const { return m_currentFrame; }
+    bool isFacingRight() const { return m_facingRight; }
+
+    static const int FRAME_WIDTH = 192;
+    static const int FRAME_HEIGHT = 192;
+    static constexpr float DRAW_SCALE = 0.12f;
 
 private:
-    BTNode* m_root = nullptr;
+    // only exists while walking to a nearby fossil so new tunnels can be folded into the path,
+    // freed again once the trip is over so idle workers don't carry its tables around
+    std::unique_ptr<DStarLite> m_fossilPlanner;
+
+    PathService* m_pathService = nullptr;
+    PathTicket m_fossilTicket = NO_PATH_TICKET;
+    sf::Vector2i m_fossilGoal;
+    bool m_fossilPlanWaiting = false;   // local plan put off until the frame has budget again
 
-    sf::Texture m_texture;
-    sf::Sprite  m_sprite{ m_texture };
+    // no sprite per npc, position + animation frame is all that's needed to draw one
+    sf::Vector2f m_position;
 
-    NPCState m_state = NPCState::WANDERTHESURFACE;
     sf::Vector2f m_velocity;
     float m_moveSpeed = 80.0f; // slower speed
 
@@ -76,8 +82,6 @@ private:
     int m_currentFrame = 0;
     float m_animationTimer = 0.0f;
     float m_frameTime = 0.15f;
-    const int m_frameWidth = 192;
-    const int m_frameHeight = 192;
     const int m_totalFrames = 4;
 
     void updateNPCAnimation(sf::Time dt);
@@ -0,0 +1,435 @@
+#include "PathService.h"
+#include "Map.h"
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+
+PathService::PathService()
+{
+}
+
+PathService::~PathService()
+{
+    stopWorker();
+}
+
+std::uint64_t PathService::requestKey(sf::Vector2i start, sf::Vector2i goal)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint16_t>(start.x)) << 48)
+        | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(start.y)) << 32)
+        | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(goal.x)) << 16)
+        | static_cast<std::uint64_t>(static_cast<std::uint16_t>(goal.y));
+}
+
+PathTicket PathService::request(sf::Vector2i start, sf::Vector2i goal)
+{
+    ++m_requested;
+
+    std::uint64_t key = requestKey(start, goal);
+    auto waiting = m_waitingByKey.find(key);
+
+    // same trip already queued, ride along with it
+    if (waiting != m_waitingByKey.end())
+    {
+        m_jobs[waiting->second].waiters++;
+        ++m_deduplicated;
+        return waiting->second;
+    }
+
+    PathTicket ticket = m_nextTicket++;
+    if (m_nextTicket == NO_PATH_TICKET)
+        m_nextTicket = 1;
+
+    PathJob& job = m_jobs[ticket];
+    job.start = start;
+    job.goal = goal;
+
+    m_waitingByKey[key] = ticket;
+    m_queue.push_back(ticket);
+
+    return ticket;
+}
+
+PathStatus PathService::poll(PathTicket ticket, std::vector<sf::Vector2i>& path)
+{
+    auto it = m_jobs.find(ticket);
+
+    if (it == m_jobs.end())
+    {
+        path.clear();
+        return PathStatus::Failed;
+    }
+
+    PathJob& job = it->second;
+
+    if (job.status == PathStatus::Pending)
+        return PathStatus::Pending;
+
+    PathStatus status = job.status;
+    path = job.path;
+
+    if (--job.waiters <= 0)
+        m_jobs.erase(it);
+
+    return status;
+}
+
+void PathService::cancel(PathTicket ticket)
+{
+    auto it = m_jobs.find(ticket);
+
+    if (it == m_jobs.end() || --it->second.waiters > 0)
+        return;
+
+    // the queue and the worker skip tickets that are gone
+    auto waiting = m_waitingByKey.find(requestKey(it->second.start, it->second.goal));
+    if (waiting != m_waitingByKey.end() && waiting->second == ticket)
+        m_waitingByKey.erase(waiting);
+
+    m_jobs.erase(it);
+}
+
+void PathService::finishJob(PathTicket ticket, bool found)
+{
+    PathJob& job = m_jobs[ticket];
+    job.status = found ? PathStatus::Found : PathStatus::Failed;
+
+    if (!found)
+        job.path.clear();
+
+    auto waiting = m_waitingByKey.find(requestKey(job.start, job.goal));
+    if (waiting != m_waitingByKey.end() && waiting->second == ticket)
+        m_waitingByKey.erase(waiting);
+
+    m_finished.push_back(ticket);
+    ++m_completed;
+}
+
+void PathService::takeFinishedTickets(std::vector<PathTicket>& tickets)
+{
+    tickets.clear();
+    tickets.swap(m_finished);
+}
+
+void PathService::update(Map& map)
+{
+    collectResults();
+
+    // whatever the local searches left this frame pays for chunk upkeep and then the queue
+    int budget = m_frameBudgetLeft;
+    budget -= map.getPathGraph().rebuildDirtyChunks(map.getSolidView(), PATH_CHUNK_REBUILDS_PER_FRAME);
+
+    if (m_threaded)
+    {
+        dispatchToWorker(map, budget);
+    }
+    else
+    {
+        while (budget > 0 && !m_queue.empty())
+        {
+            stepFrontJob(map, budget);
+        }
+    }
+
+    // topped up for the next frame, less anything this one went over by
+    m_frameBudgetLeft = m_expansionBudget + std::min(budget, 0);
+}
+
+bool PathService::planJob(const PathJob& job, Map& map, std::vector<sf::Vector2i>& waypoints, int& budget)
+{
+    waypoints.clear();
+
+    // even a job that fails straight away costs something so a flood of them can't hog a frame
+    budget -= 1;
+
+    if (!map.isReachable(job.start, job.goal))
+        return false;
+
+    // long trips get a coarse plan first, each leg of it is then searched on its own
+    int distance = std::abs(job.goal.x - job.start.x) + std::abs(job.goal.y - job.start.y);
+
+    if (distance < PATH_CHUNK_SIZE * 2)
+    {
+        waypoints.push_back(job.goal);
+        return true;
+    }
+
+    HierarchicalPathfinder& graph = map.getPathGraph();
+    bool planned = graph.planWaypoints(map.getSolidView(), job.start, job.goal, waypoints);
+    budget -= graph.getLastExpanded();
+    m_expanded += graph.getLastExpanded();
+
+    return planned;
+}
+
+void PathService::stepFrontJob(Map& map, int& budget)
+{
+    PathTicket ticket = m_queue.front();
+    auto it = m_jobs.find(ticket);
+
+    if (it == m_jobs.end() || it->second.status != PathStatus::Pending)
+    {
+        m_queue.pop_front();
+        return;
+    }
+
+    PathJob& job = it->second;
+
+    if (!job.started)
+    {
+        job.started = true;
+        job.path.clear();
+        job.waypointIndex = 0;
+        job.segmentStart = job.start;
+
+        if (!planJob(job, map, job.waypoints, budget))
+        {
+            finishJob(ticket, false);
+            m_queue.pop_front();
+            return;
+        }
+
+        if (!beginNextSegment(job, map))
+        {
+            finishJob(ticket, true);
+            m_queue.pop_front();
+            return;
+        }
+    }
+
+    int before = m_search.getLastExpanded();
+    SearchStatus status = m_search.step(map.getSolidView(), budget);
+    int used = m_search.getLastExpanded() - before;
+
+    budget -= used;
+    m_expanded += used;
+
+    if (status == SearchStatus::Running)
+        return;
+
+    if (status == SearchStatus::Failed)
+    {
+        finishJob(ticket, false);
+        m_queue.pop_front();
+        return;
+    }
+
+    m_search.getPath(m_segment);
+    job.path.insert(job.path.end(), m_segment.begin(), m_segment.end());
+    job.segmentStart = job.waypoints[job.waypointIndex];
+    ++job.waypointIndex;
+
+    if (!beginNextSegment(job, map))
+    {
+        finishJob(ticket, true);
+        m_queue.pop_front();
+    }
+}
+
+bool PathService::beginNextSegment(PathJob& job, Map& map)
+{
+    while (job.waypointIndex < job.waypoints.size() && job.waypoints[job.waypointIndex] == job.segmentStart)
+    {
+        ++job.waypointIndex;
+    }
+
+    if (job.waypointIndex >= job.waypoints.size())
+        return false;
+
+    m_search.begin(map.getSolidView(), job.segmentStart, job.waypoints[job.waypointIndex]);
+    return true;
+}
+
+void PathService::setThreaded(bool threaded)
+{
+    if (threaded == m_threaded)
+        return;
+
+    if (threaded)
+    {
+        m_stop = false;
+        m_worker = std::thread(&PathService::workerLoop, this);
+    }
+    else
+    {
+        stopWorker();
+    }
+
+    m_threaded = threaded;
+    std::cout << "Path searches now run " << (m_threaded ? "on a worker thread" : "time sliced on the main thread") << "\n";
+}
+
+void PathService::stopWorker()
+{
+    if (!m_worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_condition.notify_all();
+    m_worker.join();
+
+    // anything the worker never picked up goes back to the front of the queue
+    for (auto it = m_inbox.rbegin(); it != m_inbox.rend(); ++it)
+    {
+        m_queue.push_front(it->ticket);
+        --m_inFlight;
+    }
+
+    m_inbox.clear();
+}
+
+void PathService::collectResults()
+{
+    std::vector<WorkResult> results;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_outbox);
+    }
+
+    for (WorkResult& result : results)
+    {
+        --m_inFlight;
+        m_expanded += result.expanded;
+
+        auto it = m_jobs.find(result.ticket);
+        if (it == m_jobs.end() || it->second.status != PathStatus::Pending)
+            continue;
+
+        it->second.path = std::move(result.path);
+        finishJob(result.ticket, result.found);
+    }
+}
+
+void PathService::dispatchToWorker(Map& map, int& budget)
+{
+    // one batch at a time, the next goes out once the last one has come back
+    if (m_inFlight > 0 || m_queue.empty())
+        return;
+
+    std::vector<WorkItem> items;
+
+    // the chunk graph is only kept up to date on this thread, so the coarse plans are made here
+    // and only as many jobs as the budget covers go out
+    while (budget > 0 && !m_queue.empty())
+    {
+        PathTicket ticket = m_queue.front();
+        m_queue.pop_front();
+
+        auto it = m_jobs.find(ticket);
+        if (it == m_jobs.end() || it->second.status != PathStatus::Pending)
+            continue;
+
+        PathJob& job = it->second;
+        job.started = false;
+
+        WorkItem item;
+        item.ticket = ticket;
+        item.start = job.start;
+
+        if (!planJob(job, map, item.waypoints, budget))
+        {
+            finishJob(ticket, false);
+            continue;
+        }
+
+        items.push_back(std::move(item));
+    }
+
+    if (items.empty())
+        return;
+
+    SolidGridView grid = map.getSolidView();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_snapshotBits.assign(grid.bits, grid.bits + static_cast<size_t>(grid.rows) * grid.wordsPerRow);
+        m_snapshot = grid;
+        m_snapshot.bits = nullptr;
+        m_inbox = std::move(items);
+        m_inFlight = static_cast<int>(m_inbox.size());
+    }
+
+    m_condition.notify_one();
+}
+
+void PathService::workerLoop()
+{
+    GridAStar search;
+    std::vector<WorkItem> batch;
+    std::vector<std::uint64_t> bits;
+    std::vector<sf::Vector2i> segment;
+    SolidGridView grid;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_inbox.empty(); });
+
+            if (m_stop)
+                return;
+
+            batch.swap(m_inbox);
+            m_inbox.clear();
+            // the main thread refills the other buffer next batch, after this one has come back
+            bits.swap(m_snapshotBits);
+            grid = m_snapshot;
+        }
+
+        grid.bits = bits.data();
+
+        std::vector<WorkResult> results;
+        results.reserve(batch.size());
+
+        for (const WorkItem& item : batch)
+        {
+            WorkResult result;
+            result.ticket = item.ticket;
+            result.found = true;
+
+            sf::Vector2i from = item.start;
+
+            for (sf::Vector2i waypoint : item.waypoints)
+            {
+                if (waypoint == from)
+                    continue;
+
+                bool found = search.findPath(grid, from, waypoint, segment);
+                result.expanded += search.getLastExpanded();
+
+                if (!found)
+                {
+                    result.found = false;
+                    result.path.clear();
+                    break;
+                }
+
+                result.path.insert(result.path.end(), segment.begin(), segment.end());
+                from = waypoint;
+            }
+
+            results.push_back(std::move(result));
+        }
+
+        batch.clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (WorkResult& result : results)
+        {
+            m_outbox.push_back(std::move(result));
+        }
+    }
+}
+
+void PathService::printStats() const
+{
+    std::cout << "[PathService] " << m_requested << " requested | " << m_deduplicated << " shared | "
+        << m_completed << " completed | " << getPendingCount() << " pending | avg "
+        << (m_completed > 0 ? m_expanded / m_completed : 0) << " nodes per path | "
+        << (m_threaded ? "worker thread" : "time sliced") << "\n";
+}
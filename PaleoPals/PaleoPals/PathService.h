@@ -0,0 +1,145 @@
+#pragma once
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "GridAStar.h"
+
+class Map;
+
+// roughly a millisecond of A* per frame
+const int PATH_EXPANSIONS_PER_FRAME = 20000;
+// chunk graph upkeep done ahead of time each frame so a query rarely has to rebuild much itself
+const int PATH_CHUNK_REBUILDS_PER_FRAME = 8;
+
+using PathTicket = std::uint32_t;
+const PathTicket NO_PATH_TICKET = 0;
+
+enum class PathStatus
+{
+    Pending,
+    Found,
+    Failed
+};
+
+// Path requests from every worker go through here instead of being searched inside the
+// behaviour tree tick. update() spends a fixed number of node expansions per frame on the
+// queue, oldest first, so a burst of requests spreads over several frames instead of stalling
+// one. Identical requests still waiting share a ticket. With threading on, long trips are still
+// planned over the chunk graph here on the main thread out of the same budget, only the legs
+// between waypoints go to a worker thread, searched against a copy of the solid bitset and
+// handed back on a later update().
+class PathService
+{
+public:
+    PathService();
+    ~PathService();
+
+    PathTicket request(sf::Vector2i start, sf::Vector2i goal);
+    // Found / Failed hand the ticket back, poll it once more and it reads as Failed
+    PathStatus poll(PathTicket ticket, std::vector<sf::Vector2i>& path);
+    void cancel(PathTicket ticket);
+
+    // every ticket answered since the last call, so whoever is waiting on one can be woken
+    void takeFinishedTickets(std::vector<PathTicket>& tickets);
+
+    // searches run by the caller itself (d* lite plans) draw on the same per frame budget,
+    // reserve says whether any is left and charge takes off what was actually used
+    bool reserveLocalSearch() const { return m_frameBudgetLeft > 0; }
+    void chargeLocalSearch(int expansions) { m_frameBudgetLeft -= expansions; m_expanded += expansions; }
+
+    // main thread, once per frame. chunk graph upkeep comes out of the budget too, and whatever
+    // a frame overspends is taken off the next one
+    void update(Map& map);
+
+    void setExpansionBudget(int expansions) { m_expansionBudget = expansions; }
+    void setThreaded(bool threaded);
+    bool isThreaded() const { return m_threaded; }
+
+    int getPendingCount() const { return static_cast<int>(m_queue.size()) + m_inFlight; }
+    void printStats() const;
+
+private:
+    struct PathJob
+    {
+        sf::Vector2i start;
+        sf::Vector2i goal;
+        PathStatus status = PathStatus::Pending;
+        std::vector<sf::Vector2i> path;
+        int waiters = 1;
+
+        // sliced search state, only used by the job at the front of the queue
+        bool started = false;
+        std::vector<sf::Vector2i> waypoints;
+        size_t waypointIndex = 0;
+        sf::Vector2i segmentStart;
+    };
+
+    struct WorkItem
+    {
+        PathTicket ticket = NO_PATH_TICKET;
+        sf::Vector2i start;
+        std::vector<sf::Vector2i> waypoints;    // ends with the goal
+    };
+
+    struct WorkResult
+    {
+        PathTicket ticket = NO_PATH_TICKET;
+        bool found = false;
+        int expanded = 0;
+        std::vector<sf::Vector2i> path;
+    };
+
+    static std::uint64_t requestKey(sf::Vector2i start, sf::Vector2i goal);
+
+    void finishJob(PathTicket ticket, bool found);
+    // coarse plan for a job, just the goal for short trips, false if it can't be reached at all
+    bool planJob(const PathJob& job, Map& map, std::vector<sf::Vector2i>& waypoints, int& budget);
+    void stepFrontJob(Map& map, int& budget);
+    bool beginNextSegment(PathJob& job, Map& map);
+
+    void collectResults();
+    void dispatchToWorker(Map& map, int& budget);
+    void workerLoop();
+    void stopWorker();
+
+    std::unordered_map<PathTicket, PathJob> m_jobs;
+    std::unordered_map<std::uint64_t, PathTicket> m_waitingByKey;     // only jobs not yet finished
+    std::deque<PathTicket> m_queue;
+    std::vector<PathTicket> m_finished;
+    PathTicket m_nextTicket = 1;
+
+    GridAStar m_search;
+    std::vector<sf::Vector2i> m_segment;
+    int m_expansionBudget = PATH_EXPANSIONS_PER_FRAME;
+    int m_frameBudgetLeft = PATH_EXPANSIONS_PER_FRAME;
+
+    // worker thread, everything below is guarded by m_mutex
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<WorkItem> m_inbox;
+    std::vector<WorkResult> m_outbox;
+    std::vector<std::uint64_t> m_snapshotBits;     // swapped with the worker's copy, never copied twice
+    SolidGridView m_snapshot;
+    bool m_stop = false;
+
+    // main thread only
+    bool m_threaded = false;
+    int m_inFlight = 0;
+
+    // lifetime counters
+    long long m_requested = 0;
+    long long m_deduplicated = 0;
+    long long m_completed = 0;
+    long long m_expanded = 0;
+};
+
+#endif // !PATH_SERVICE_H
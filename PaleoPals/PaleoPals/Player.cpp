@@ -1,20 +1,15 @@
 ﻿#include "Player.h"
 #include "Map.h"
 #include "Fossil.h"
+#include "AssetCache.h"
 #include <iostream>
 #include <cmath>
 
 Player::Player()
+    : m_texture(AssetCache::get().getTexture("ASSETS/IMAGES/Sprites/Characters/paleontologist_walk.png"))
 {
     std::cout << "Player constructor START\n";
 
-    if (!m_texture.loadFromFile("ASSETS/IMAGES/Sprites/Characters/paleontologist_walk.png"))
-    {
-        std::cerr << "Failed to load player texture!\n";
-
-    }
-
-    m_sprite.setTexture(m_texture);
     m_sprite.setTextureRect(sf::IntRect({ 0, 0 }, { m_frameWidth, m_frameHeight }));
     m_sprite.setOrigin(sf::Vector2f(m_frameWidth / 2.0f, m_frameHeight));
     m_sprite.setScale(sf::Vector2f(0.2f, 0.2f));
@@ -175,12 +170,9 @@ void Player::checkCollisions(Map& map)
         return row * tileSize + tileOffsetY;
         };
 
-    auto inBounds = [&](int row, int col) -> bool {
-        return row >= 0 && row < map.getRowCount() &&
-            col >= 0 && col < map.getColumnCount();
-        };
-    auto solid = [&](int row, int col) -> bool {
-        return inBounds(row, col) && map.getTileHardness(row, col) > 0;
+    // any solid tile in rows [firstRow, lastRow] and cols [firstCol, lastCol], checked a word at a time
+    auto solidSpan = [&](int firstRow, int lastRow, int firstCol, int lastCol) -> bool {
+        return map.anySolidInRect(TileRange{ firstRow, lastRow + 1, firstCol, lastCol + 1 });
         };
 
     sf::Vector2f pos = m_sprite.getPosition(); 
@@ -194,7 +186,7 @@ void Player::checkCollisions(Map& map)
         int colL = toTileCol(pos.x - halfW + 1.f);
         int colR = toTileCol(pos.x + halfW - 1.f);
 
-        if (solid(footRow, colL) || solid(footRow, colR))
+        if (solidSpan(footRow, footRow, colL, colR))
         {
             float surfaceY = tileTop(footRow); 
 
@@ -216,7 +208,7 @@ void Player::checkCollisions(Map& map)
         int colL = toTileCol(pos.x - halfW + 1.f);
         int colR = toTileCol(pos.x + halfW - 1.f);
 
-        if (solid(headRow, colL) || solid(headRow, colR))
+        if (solidSpan(headRow, headRow, colL, colR))
         {
             float ceilBottom = tileTop(headRow) + tileSize;
             m_sprite.setPosition(sf::Vector2f(pos.x, ceilBottom + playerHeight));
@@ -228,11 +220,8 @@ void Player::checkCollisions(Map& map)
 
     if (m_velocity.x != 0)
     {
-        float sampleYs[3] = {
-            pos.y - playerHeight + 2.f,   
-            pos.y - playerHeight * 0.5f,  
-            pos.y - 2.f                   
-        };
+        int topRow = toTileRow(pos.y - playerHeight + 2.f);
+        int bottomRow = toTileRow(pos.y - 2.f);
 
         if (m_velocity.x < 0)
         {
@@ -240,13 +229,7 @@ void Player::checkCollisions(Map& map)
             float leftEdge = pos.x - halfW;
             int leftCol = toTileCol(leftEdge);
 
-            bool hit = false;
-            for (auto sampleY : sampleYs)
-            {
-                int row = toTileRow(sampleY);
-                if (solid(row, leftCol)) { hit = true; break; }
-            }
-            if (hit)
+            if (solidSpan(topRow, bottomRow, leftCol, leftCol))
             {
                 m_velocity.x = 0;
                 float newX = tileLeft(leftCol) + tileSize + halfW;
@@ -258,13 +241,7 @@ void Player::checkCollisions(Map& map)
             float rightEdge = pos.x + halfW;
             int rightCol = toTileCol(rightEdge);
 
-            bool hit = false;
-            for (auto sampleY : sampleYs)
-            {
-                int row = toTileRow(sampleY);
-                if (solid(row, rightCol)) { hit = true; break; }
-            }
-            if (hit)
+            if (solidSpan(topRow, bottomRow, rightCol, rightCol))
             {
                 m_velocity.x = 0;
                 float newX = tileLeft(rightCol) - halfW;
@@ -279,28 +256,15 @@ void Player::tryPickupCollectible(Map& map)
     sf::Vector2f playerPos = m_sprite.getPosition();
     FossilManager& fossilManager = map.getFossilManager();
     float tileSize = map.getTileSize();
-    float tileOffsetX = (WINDOW_X - map.getColumnCount() * tileSize) / 2.0f;
-    float tileOffsetY = WINDOW_Y / 2.0f;
 
-    
     sf::Vector2f bodyCentre = playerPos - sf::Vector2f(0.f, tileSize * 0.8f);
-    int playerCol = static_cast<int>(std::floor((bodyCentre.x - tileOffsetX) / tileSize));
-    int playerRow = static_cast<int>(std::floor((bodyCentre.y - tileOffsetY) / tileSize));
 
-	auto& allCollectibles = fossilManager.getAllCollectibles();
-    
-    for (auto& c : allCollectibles)
-    {
-
-        if (c.isPickedUp) continue;
-
-        sf::Vector2f collectiblePos = c.sprite.getPosition();
-        sf::Vector2f diff = collectiblePos - bodyCentre;
-        float distSq = diff.x * diff.x + diff.y * diff.y;
-        float pickupRadius = getPickupRadius();
+    // only the buckets around the player are searched
+    CollectibleHandle nearest = fossilManager.findNearest(bodyCentre, getPickupRadius());
 
-        if (distSq > pickupRadius * pickupRadius)
-            continue;
+    if (const Collectible* picked = fossilManager.get(nearest))
+    {
+        const Collectible& c = *picked;
 
         CollectedItem item;
         item.collectibleIndex = c.collectibleIndex;
@@ -330,13 +294,10 @@ void Player::tryPickupCollectible(Map& map)
 
         m_inventory.push_back(item);
         m_newPickups.push_back(item);
-        
-        c.isPickedUp = true;
-        c.sprite.setPosition(sf::Vector2f(-10000.f, -10000.f));
 
-        std::cout << "[Pickup] " << item.name << " (type: " << item.type << ")" << " | Inventory size: " << m_inventory.size() << "\n";
+        fossilManager.removeCollectible(nearest);
 
-        return; 
+        std::cout << "[Pickup] " << item.name << " (type: " << item.type << ")" << " | Inventory size: " << m_inventory.size() << "\n";
     }
 }
 
@@ -369,7 +330,7 @@ void Player::setFrame(int frame)
 
     m_currentFrame = frame;
 
-    if (m_texture.getSize().x == 0 || m_texture.getSize().y == 0)
+    if (m_texture->getSize().x == 0 || m_texture->getSize().y == 0)
     {
         return;
     }
@@ -467,23 +428,23 @@ void Player::updateMiningRay(sf::Time dt, Map& map, const sf::RenderWindow& wind
     dir /= len;
 
     float rayLength = m_rayBaseLength + pickaxeRadiusLevel * 10.f;
-    float tileSize = map.getTileSize();
 
-    for (float t = 0; t < rayLength; t += tileSize * 0.5f)
-    {
-        sf::Vector2f samplePoint = playerPos + dir * t;
-        sf::Vector2i tile = worldToTile(samplePoint, map);
+    // exact list of cells under the ray, each one once, corners included
+    map.traverseCells(playerPos, playerPos + dir * rayLength, m_rayCells);
 
-        if (tile.x < 0 || tile.y < 0 || tile.x >= map.getColumnCount() || tile.y >= map.getRowCount())
-            continue;
+    m_rayHits.clear();
 
-        if (map.getTileHardness(tile.y, tile.x) > 0)
+    for (const sf::Vector2i& tile : m_rayCells)
+    {
+        if (map.isSolid(tile.y, tile.x))
         {
-            map.damageTile(tile.y, tile.x, getRayDamage());
-            //break;
+            m_rayHits.push_back({ tile.y, tile.x, getRayDamage() });
         }
     }
 
+    // applied with everyone else's digging at the end of the tick
+    map.damageTiles(m_rayHits);
+
     m_rayDamageCooldown = m_rayTickDelay;
 
 }
@@ -6,6 +6,7 @@
 #include "constants.h"
 #include <vector>
 #include <string>
+#include <memory>
 #include <algorithm>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
@@ -13,6 +14,7 @@
 
 class Map;
 class Collectible;
+struct TileDamage;
 
 struct CollectedItem
 {
@@ -89,8 +91,8 @@ public:
 
 
 private:
-    sf::Texture m_texture;
-    sf::Sprite m_sprite{m_texture};
+    std::shared_ptr<sf::Texture> m_texture;    // shared with every paleontologist through AssetCache
+    sf::Sprite m_sprite{ *m_texture };
     sf::CircleShape m_pickupRadiusVisual; 
 	float pickupRadius = 24.0f; 
 
@@ -104,6 +106,9 @@ private:
 
     PlayerState m_state = PlayerState::Idle;
 
+    std::vector<sf::Vector2i> m_rayCells;  // reused every mining tick
+    std::vector<TileDamage> m_rayHits;
+
     std::vector<CollectedItem> m_inventory;
 	std::vector<CollectedItem> m_newPickups; 
     float m_interactionRadius = 24.0f; 
@@ -0,0 +1,96 @@
+#pragma once
+#ifndef SOLID_GRID_H
+#define SOLID_GRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int popCount64(std::uint64_t bits)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(bits));
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+// bits of one occupancy word that fall inside cols [firstCol, lastCol)
+inline std::uint64_t columnMask(int word, int firstCol, int lastCol)
+{
+    int low = std::max(firstCol - word * 64, 0);
+    int high = std::min(lastCol - word * 64, 64);
+
+    if (high <= low)
+    {
+        return 0;
+    }
+
+    std::uint64_t mask = (high == 64) ? ~0ull : ((1ull << high) - 1);
+    return mask & (~0ull << low);
+}
+
+// read only view of a solid bitset laid out like Map's, one bit per tile and rows padded to whole words
+struct SolidGridView
+{
+    const std::uint64_t* bits = nullptr;
+    int wordsPerRow = 0;
+    int rows = 0;
+    int cols = 0;
+
+    bool isOpen(int row, int col) const
+    {
+        if (row < 0 || col < 0 || row >= rows || col >= cols)
+            return false;
+        return ((bits[static_cast<size_t>(row) * wordsPerRow + (col >> 6)] >> (col & 63)) & 1u) == 0;
+    }
+
+    // solid tiles in cols [firstCol, lastCol) of one row, 64 at a time
+    int countSolidInRow(int row, int firstCol, int lastCol) const
+    {
+        firstCol = std::max(firstCol, 0);
+        lastCol = std::min(lastCol, cols);
+
+        if (row < 0 || row >= rows || firstCol >= lastCol)
+        {
+            return 0;
+        }
+
+        const std::uint64_t* words = bits + static_cast<size_t>(row) * wordsPerRow;
+        int count = 0;
+
+        for (int word = firstCol >> 6; word <= (lastCol - 1) >> 6; ++word)
+        {
+            count += popCount64(words[word] & columnMask(word, firstCol, lastCol));
+        }
+
+        return count;
+    }
+
+    // first solid row at or below row, -1 if none
+    int firstSolidBelow(int row, int col) const
+    {
+        if (col < 0 || col >= cols)
+        {
+            return -1;
+        }
+
+        int word = col >> 6;
+        std::uint64_t bit = 1ull << (col & 63);
+
+        for (int r = std::max(row, 0); r < rows; ++r)
+        {
+            if (bits[static_cast<size_t>(r) * wordsPerRow + word] & bit)
+            {
+                return r;
+            }
+        }
+
+        return -1;
+    }
+};
+
+#endif // !SOLID_GRID_H
@@ -0,0 +1,116 @@
+#include "TextureAtlas.h"
+#include <iostream>
+#include <algorithm>
+
+TextureAtlas::TextureAtlas()
+{
+}
+
+bool TextureAtlas::addImageFromFile(const std::string& name, const std::string& filepath)
+{
+    sf::Image image;
+
+    if (!image.loadFromFile(filepath))
+    {
+        std::cerr << "TextureAtlas: failed to load " << filepath << "\n";
+        return false;
+    }
+
+    addImage(name, image);
+    return true;
+}
+
+void TextureAtlas::addImage(const std::string& name, const sf::Image& image)
+{
+    m_pending.push_back({ name, image });
+}
+
+bool TextureAtlas::build()
+{
+    if (m_pending.empty())
+    {
+        std::cerr << "TextureAtlas: nothing to build\n";
+        return false;
+    }
+
+    // tallest first keeps the shelves tight
+    std::vector<size_t> order(m_pending.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            return m_pending[a].image.getSize().y > m_pending[b].image.getSize().y;
+        });
+
+    unsigned int atlasWidth = MIN_WIDTH;
+    for (const auto& pending : m_pending)
+    {
+        atlasWidth = std::max(atlasWidth, pending.image.getSize().x);
+    }
+
+    // first pass just places everything so we know how tall the atlas is
+    std::vector<sf::Vector2u> positions(m_pending.size());
+    unsigned int x = 0;
+    unsigned int shelfY = 0;
+    unsigned int shelfHeight = 0;
+
+    for (size_t i : order)
+    {
+        sf::Vector2u size = m_pending[i].image.getSize();
+
+        if (x + size.x > atlasWidth)
+        {
+            shelfY += shelfHeight + PADDING;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        positions[i] = sf::Vector2u(x, shelfY);
+        x += size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+
+    unsigned int atlasHeight = shelfY + shelfHeight;
+
+    sf::Image atlas(sf::Vector2u(atlasWidth, std::max(atlasHeight, 1u)), sf::Color::Transparent);
+
+    m_rects.clear();
+
+    for (size_t i = 0; i < m_pending.size(); ++i)
+    {
+        if (!atlas.copy(m_pending[i].image, positions[i]))
+        {
+            std::cerr << "TextureAtlas: failed to copy " << m_pending[i].name << "\n";
+            return false;
+        }
+
+        m_rects[m_pending[i].name] = sf::IntRect(sf::Vector2i(positions[i]), sf::Vector2i(m_pending[i].image.getSize()));
+    }
+
+    m_pending.clear();
+
+    if (!m_texture.loadFromImage(atlas))
+    {
+        std::cerr << "TextureAtlas: failed to upload atlas texture\n";
+        return false;
+    }
+
+    std::cout << "TextureAtlas: packed " << m_rects.size() << " images into " << atlasWidth << "x" << atlasHeight << "\n";
+    return true;
+}
+
+sf::IntRect TextureAtlas::getRect(const std::string& name) const
+{
+    auto it = m_rects.find(name);
+
+    if (it == m_rects.end())
+    {
+        std::cerr << "TextureAtlas: no image called " << name << "\n";
+        return sf::IntRect();
+    }
+
+    return it->second;
+}
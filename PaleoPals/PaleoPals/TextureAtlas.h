@@ -0,0 +1,43 @@
+#pragma once
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <map>
+
+// Packs a set of images into one texture at load time so things that share it
+// can be drawn without switching textures. Add images, call build(), then look
+// sub-rects up by the name they were added with.
+class TextureAtlas
+{
+public:
+    TextureAtlas();
+
+    bool addImageFromFile(const std::string& name, const std::string& filepath);
+    void addImage(const std::string& name, const sf::Image& image);
+
+    // shelf packs every added image, uploads the result and frees the source images
+    bool build();
+
+    const sf::Texture& getTexture() const { return m_texture; }
+    bool hasRect(const std::string& name) const { return m_rects.count(name) > 0; }
+    sf::IntRect getRect(const std::string& name) const;
+
+private:
+    struct PendingImage
+    {
+        std::string name;
+        sf::Image image;
+    };
+
+    std::vector<PendingImage> m_pending;
+    std::map<std::string, sf::IntRect> m_rects;
+    sf::Texture m_texture;
+
+    static const unsigned int MIN_WIDTH = 1024;
+    static const unsigned int PADDING = 2;
+};
+
+#endif // TEXTURE_ATLAS_H
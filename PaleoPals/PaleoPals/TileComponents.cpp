@@ -0,0 +1,112 @@
+#include "TileComponents.h"
+#include <utility>
+
+void TileComponents::resize(int rows, int cols)
+{
+    if (cols != m_cols)
+    {
+        clear();
+        m_cols = cols;
+    }
+
+    m_rows = rows;
+    m_parent.resize(static_cast<size_t>(rows) * cols, -1);
+    m_size.resize(static_cast<size_t>(rows) * cols, 1);
+}
+
+void TileComponents::clear()
+{
+    m_rows = 0;
+    m_cols = 0;
+    m_parent.clear();
+    m_size.clear();
+}
+
+int TileComponents::findRoot(int cell) const
+{
+    while (m_parent[cell] != cell)
+    {
+        m_parent[cell] = m_parent[m_parent[cell]];
+        cell = m_parent[cell];
+    }
+
+    return cell;
+}
+
+void TileComponents::open(int row, int col)
+{
+    if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
+        return;
+
+    int cell = row * m_cols + col;
+
+    // already open, merging again would double count its size
+    if (m_parent[cell] >= 0)
+        return;
+
+    m_parent[cell] = cell;
+    m_size[cell] = 1;
+
+    const int rowStep[4] = { -1, 1, 0, 0 };
+    const int colStep[4] = { 0, 0, -1, 1 };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int neighbour = getComponent(row + rowStep[i], col + colStep[i]);
+
+        if (neighbour < 0)
+            continue;
+
+        int root = findRoot(cell);
+
+        if (root == neighbour)
+            continue;
+
+        // smaller set goes under the bigger one
+        if (m_size[root] < m_size[neighbour])
+            std::swap(root, neighbour);
+
+        m_parent[neighbour] = root;
+        m_size[root] += m_size[neighbour];
+    }
+}
+
+int TileComponents::getComponent(int row, int col) const
+{
+    if (row < 0 || col < 0 || row >= m_rows || col >= m_cols)
+        return -1;
+
+    int cell = row * m_cols + col;
+
+    if (m_parent[cell] < 0)
+        return -1;
+
+    return findRoot(cell);
+}
+
+bool TileComponents::isReachable(const SolidGridView& grid, sf::Vector2i from, sf::Vector2i to) const
+{
+    int target = getComponent(to.y, to.x);
+
+    if (target < 0)
+        return false;
+
+    if (getComponent(from.y, from.x) == target)
+        return true;
+
+    // still inside solid ground, any open side that joins up counts
+    bool insideGrid = from.y >= 0 && from.x >= 0 && from.y < grid.rows && from.x < grid.cols;
+
+    if (insideGrid && !grid.isOpen(from.y, from.x))
+    {
+        const sf::Vector2i steps[4] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+
+        for (const sf::Vector2i& step : steps)
+        {
+            if (getComponent(from.y + step.y, from.x + step.x) == target)
+                return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef TILE_COMPONENTS_H
+#define TILE_COMPONENTS_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "SolidGrid.h"
+
+// union-find over dug out tiles, tiles never close again so sets only ever merge.
+// parent is -1 while a tile is solid, mutable for path halving in const lookups
+class TileComponents
+{
+public:
+    // new rows come in solid, changing the column count starts over
+    void resize(int rows, int cols);
+    void clear();
+    void open(int row, int col);
+
+    // connected pockets of dug out tiles, -1 for solid tiles or outside the grid
+    int getComponent(int row, int col) const;
+    // from may still be solid (a worker stood in the tile it's digging), then its open sides count
+    bool isReachable(const SolidGridView& grid, sf::Vector2i from, sf::Vector2i to) const;
+
+private:
+    int findRoot(int cell) const;
+
+    int m_rows = 0;
+    int m_cols = 0;
+    mutable std::vector<int> m_parent;
+    std::vector<int> m_size;
+};
+
+#endif // !TILE_COMPONENTS_H
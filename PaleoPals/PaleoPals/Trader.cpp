@@ -5,10 +5,10 @@
 
 Trader::Trader() = default;
 
-bool Trader::loadTraderFromConfig(const nlohmann::json& data)
+bool Trader::loadTraderFromConfig(const BuildingConfig& data)
 {
 
-    if (!m_texture.loadFromFile(data["texture"].get<std::string>()))
+    if (!m_texture.loadFromFile(data.texture))
     {
         std::cerr << "Failed to load trader texture" << std::endl;
         return false;
@@ -16,10 +16,10 @@ bool Trader::loadTraderFromConfig(const nlohmann::json& data)
 
 
 
-    m_frameWidth = data["frameWidth"].get<int>();
-    m_frameHeight = data["frameHeight"].get<int>();
+    m_frameWidth = data.frameWidth;
+    m_frameHeight = data.frameHeight;
 
-    m_position = sf::Vector2f(data["position"]["x"].get<float>(), data["position"]["y"].get<float>());
+    m_position = data.position;
 
     m_sprite.setTexture(m_texture);
     m_sprite.setTextureRect(sf::IntRect({ 0,0 }, { m_frameWidth,m_frameHeight }));
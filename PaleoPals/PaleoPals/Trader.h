@@ -2,15 +2,15 @@
 #ifndef TRADER_H
 #define TRADER_H
 
-#include <json.hpp>
 #include <SFML/Graphics.hpp>
+#include "GameConfig.h"
 
 
 class Trader {
 public:
 	Trader();
 
-	bool loadTraderFromConfig(const nlohmann::json& data);
+	bool loadTraderFromConfig(const BuildingConfig& data);
 	void updateTraderHover(const sf::RenderWindow& window);
 	void drawTrader(sf::RenderWindow& window);
 
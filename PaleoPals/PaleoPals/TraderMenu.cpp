@@ -1,8 +1,10 @@
 #include "TraderMenu.h"
+#include "AssetCache.h"
 #include <SFML/Graphics.hpp>
 #include <iostream>
 
 TraderMenu::TraderMenu()
+    : m_font(AssetCache::get().getFont("ASSETS/FONTS/Jersey20-Regular.ttf"))
 {
     m_overlay.setSize(sf::Vector2f(10000.0f, 10000.0f)); 
     m_overlay.setFillColor(sf::Color(0, 0, 0, 100));
@@ -64,14 +66,9 @@ TraderMenu::TraderMenu()
     m_closeButton.setOutlineColor(sf::Color(255, 255, 255));
     m_closeButton.setOutlineThickness(2.0f);
 
-    if (!m_font.openFromFile("ASSETS/FONTS/Jersey20-Regular.ttf"))
-    {
-        std::cout << "TraderMenu: failed to load font\n";
-    }
-
     auto setupText = [&](sf::Text& text, const std::string& str)
         {
-            text.setFont(m_font);
+            text.setFont(*m_font);
             text.setString(str);
             text.setCharacterSize(20);
             text.setFillColor(sf::Color::White);
@@ -219,6 +216,8 @@ void TraderMenu::draw(sf::RenderWindow& window)
     sf::View prev = window.getView();
     window.setView(window.getDefaultView());
 
+    m_hirePaleoText.setString("Hire Paleontologist ($" + std::to_string(getHirePaleontologistCost()) + ")");
+
     m_upgrade1Text.setString("Length +" + std::to_string(upgrade1Level) +" ($" + std::to_string(getUpgrade1Cost()) + ")");
 
     m_upgrade2Text.setString("Damage +" + std::to_string(upgrade2Level) +" ($" + std::to_string(getUpgrade2Cost()) + ")");
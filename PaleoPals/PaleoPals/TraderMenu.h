@@ -3,6 +3,7 @@
 #define TRADERMENU_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 
 enum class HireAction
 {
@@ -36,6 +37,8 @@ public:
     int upgrade3Level = 0; // pickup radius
     int upgrade4Level = 0; // jump height
 
+    int paleontologistsHired = 0;
+
     void markUpgrade1Purchased() { m_upgrade1Purchased = true; }
     void markUpgrade2Purchased() { m_upgrade2Purchased = true; }
 
@@ -44,6 +47,8 @@ public:
     int getUpgrade3Cost() const { return 150 + upgrade3Level * 60; }
     int getUpgrade4Cost() const { return 175 + upgrade4Level * 70; }
 
+    int getHirePaleontologistCost() const { return 250 + paleontologistsHired * 150; }
+
 private:
     // Helper to update all button positions
     void updateButtonPositions(const sf::RenderWindow& window);
@@ -84,15 +89,15 @@ private:
     // Close button
     sf::RectangleShape m_closeButton;
 
-    sf::Font m_font;
-    sf::Text m_hirePaleoText{ m_font };
-    sf::Text m_hireResearcherText{ m_font };
-    sf::Text m_upgrade1Text{ m_font };
-    sf::Text m_upgrade2Text{ m_font };
-    sf::Text m_upgrade3Text{ m_font };
-    sf::Text m_upgrade4Text{ m_font };
-    sf::Text m_hiringTabText{ m_font };
-    sf::Text m_upgradesTabText{ m_font };
+    std::shared_ptr<sf::Font> m_font;
+    sf::Text m_hirePaleoText{ *m_font };
+    sf::Text m_hireResearcherText{ *m_font };
+    sf::Text m_upgrade1Text{ *m_font };
+    sf::Text m_upgrade2Text{ *m_font };
+    sf::Text m_upgrade3Text{ *m_font };
+    sf::Text m_upgrade4Text{ *m_font };
+    sf::Text m_hiringTabText{ *m_font };
+    sf::Text m_upgradesTabText{ *m_font };
 
     // upgrade state
     bool m_upgrade1Purchased = false;
@@ -0,0 +1,317 @@
+#include "WorkerManager.h"
+#include "Map.h"
+#include "AssetCache.h"
+#include "WorkerRoutines.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+WorkerManager::WorkerManager()
+    : m_texture(AssetCache::get().getTexture("ASSETS/IMAGES/Sprites/Characters/paleontologist_walk.png"))
+{
+    m_tree.loadFromFile("ASSETS/CONFIG/worker_tree.json");
+}
+
+std::unique_ptr<NPC> WorkerManager::createWorker(sf::Vector2f spawnPosition)
+{
+    auto worker = std::make_unique<NPC>(spawnPosition);
+    worker->setPathService(&m_pathService);
+
+    return worker;
+}
+
+std::uint32_t WorkerManager::nextTaskSeed(const Map& map)
+{
+    // spread consecutive counts out so neighbouring workers don't roll in step
+    ++m_tasksStarted;
+    return static_cast<std::uint32_t>(map.getWorldSeed()) ^ (m_tasksStarted * 2654435761u);
+}
+
+void WorkerManager::insertBehaviour(int workerIndex, Map& map)
+{
+    // only whichever of the two is running gets any memory per worker
+    if (m_useTasks)
+    {
+        m_tasks.insert(m_tasks.begin() + workerIndex, runWorker(*m_workers[workerIndex], map, nextTaskSeed(map)));
+        return;
+    }
+
+    int stateSize = m_tree.getStateSize();
+    m_blackboards.insert(m_blackboards.begin() + static_cast<size_t>(workerIndex) * stateSize, stateSize, BTSlot{});
+    m_tree.initState(m_blackboards.data() + static_cast<size_t>(workerIndex) * stateSize);
+}
+
+NPC& WorkerManager::hire(sf::Vector2f spawnPosition, Map& map)
+{
+    // keep hired workers in front of any stress test ones so the test can be dropped off the end
+    auto it = m_workers.insert(m_workers.begin() + m_hiredCount, createWorker(spawnPosition));
+    insertBehaviour(m_hiredCount, map);
+    m_scheduler.insertAgent(m_hiredCount);
+    ++m_hiredCount;
+
+    std::cout << "Hired paleontologist, " << m_hiredCount << " on the payroll\n";
+    return **it;
+}
+
+void WorkerManager::update(sf::Time dt, Map& map)
+{
+    sf::Clock clock;
+
+    // hand out everything dug since last tick before anyone walks on a stale path
+    const std::vector<sf::Vector2i>& opened = map.getOpenedTiles();
+
+    if (!opened.empty())
+    {
+        m_tilesOpened += opened.size();
+
+        for (auto& worker : m_workers)
+        {
+            int expanded = worker->onTilesOpened(map, opened);
+
+            if (expanded >= 0)
+            {
+                ++m_pathRepairs;
+                m_pathRepairExpanded += expanded;
+            }
+        }
+
+        // wakes anyone sleeping at one of these tiles waiting to swing at it
+        for (const sf::Vector2i& tile : opened)
+        {
+            m_scheduler.post(BTEvent::TileBroken, static_cast<std::uint32_t>(tile.y * map.getColumnCount() + tile.x));
+        }
+
+        map.clearOpenedTiles();
+    }
+
+    m_pathService.takeFinishedTickets(m_finishedPaths);
+
+    for (PathTicket ticket : m_finishedPaths)
+    {
+        m_scheduler.post(BTEvent::PathReady, ticket);
+    }
+
+    // every worker runs the same flat tree against its own slice of the blackboards,
+    // but only the ones awake or due this frame
+    int stateSize = m_tree.getStateSize();
+
+    m_scheduler.advance(dt.asSeconds());
+
+    BTTickContext context;
+    context.dt = dt.asSeconds();
+
+    for (int i : m_scheduler.collectDue())
+    {
+        context.elapsed = m_scheduler.beginTick(i);
+
+        if (m_useTasks)
+        {
+            // runWorker loops forever, this only catches one that was ended some other way
+            if (m_tasks[i].isDone())
+                m_tasks[i] = runWorker(*m_workers[i], map, nextTaskSeed(map));
+
+            m_tasks[i].resume(context);
+        }
+        else
+        {
+            m_tree.tick(*m_workers[i], map, m_blackboards.data() + static_cast<size_t>(i) * stateSize, context);
+        }
+
+        m_scheduler.endTick(i, context.yield);
+        ++m_statsTreeTicks;
+    }
+
+    // sleeping or not everyone keeps animating, surface wanderers keep walking
+    for (auto& worker : m_workers)
+    {
+        worker->updateNPC(dt, map);
+    }
+
+    // searches queued this tick are answered on later ones
+    m_pathService.update(map);
+
+    m_updateTime += clock.getElapsedTime();
+    ++m_statsTicks;
+}
+
+void WorkerManager::draw(sf::RenderWindow& window, const sf::FloatRect& viewBounds)
+{
+    sf::Clock clock;
+
+    m_vertices.clear();
+
+    float width = NPC::FRAME_WIDTH * NPC::DRAW_SCALE;
+    float height = NPC::FRAME_HEIGHT * NPC::DRAW_SCALE;
+    sf::Color tint = sf::Color::Cyan;
+
+    for (const auto& worker : m_workers)
+    {
+        // origin is bottom centre, same as the old per npc sprite
+        sf::Vector2f feet = worker->getNPCPosition();
+        sf::Vector2f topLeft(feet.x - width / 2.f, feet.y - height);
+
+        if (!viewBounds.findIntersection(sf::FloatRect(topLeft, { width, height })))
+            continue;
+
+        float left = static_cast<float>(worker->getFrame() * NPC::FRAME_WIDTH);
+        float right = left + NPC::FRAME_WIDTH;
+
+        // mirror by swapping the texture's left and right edges
+        if (!worker->isFacingRight())
+            std::swap(left, right);
+
+        float bottom = static_cast<float>(NPC::FRAME_HEIGHT);
+
+        sf::Vector2f p0 = topLeft;
+        sf::Vector2f p1(topLeft.x + width, topLeft.y);
+        sf::Vector2f p2(topLeft.x + width, topLeft.y + height);
+        sf::Vector2f p3(topLeft.x, topLeft.y + height);
+
+        m_vertices.append({ p0, tint, { left, 0.f } });
+        m_vertices.append({ p1, tint, { right, 0.f } });
+        m_vertices.append({ p2, tint, { right, bottom } });
+        m_vertices.append({ p0, tint, { left, 0.f } });
+        m_vertices.append({ p2, tint, { right, bottom } });
+        m_vertices.append({ p3, tint, { left, bottom } });
+    }
+
+    window.draw(m_vertices, m_texture.get());
+
+    m_drawTime += clock.getElapsedTime();
+    ++m_statsFrames;
+
+    sf::Time frameTime = m_frameClock.restart();
+    m_slowestFrame = std::max(m_slowestFrame, frameTime);
+
+    if (frameTime > sf::seconds(1.f / 60.f))
+        ++m_slowFrames;
+
+    if (isStressTesting())
+    {
+        reportStressStats();
+    }
+}
+
+int WorkerManager::getDeepestRow(Map& map) const
+{
+    int deepest = -1;
+
+    for (const auto& worker : m_workers)
+    {
+        deepest = std::max(deepest, map.worldToTile(worker->getNPCPosition()).y);
+    }
+
+    return deepest;
+}
+
+void WorkerManager::toggleStressTest(Map& map)
+{
+    if (isStressTesting())
+    {
+        if (m_useTasks)
+            m_tasks.resize(m_hiredCount);
+        else
+            m_blackboards.resize(static_cast<size_t>(m_hiredCount) * m_tree.getStateSize());
+
+        m_workers.resize(m_hiredCount);
+        m_scheduler.resize(m_hiredCount);
+        std::cout << "Stress test off, back to " << m_hiredCount << " workers\n";
+        return;
+    }
+
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<int> columnRoll(0, map.getColumnCount() - 1);
+
+    float tileSize = map.getTileSize();
+    sf::Vector2f gridOffset = map.getGridOffset();
+
+    m_workers.reserve(m_hiredCount + STRESS_TEST_WORKERS);
+
+    if (m_useTasks)
+        m_tasks.reserve(m_hiredCount + STRESS_TEST_WORKERS);
+    else
+        m_blackboards.reserve(static_cast<size_t>(m_hiredCount + STRESS_TEST_WORKERS) * m_tree.getStateSize());
+
+    for (int i = 0; i < STRESS_TEST_WORKERS; ++i)
+    {
+        float x = gridOffset.x + (columnRoll(gen) + 0.5f) * tileSize;
+        m_workers.push_back(createWorker(sf::Vector2f(x, gridOffset.y)));
+        insertBehaviour(static_cast<int>(m_workers.size()) - 1, map);
+        m_scheduler.addAgent();
+    }
+
+    m_statsClock.restart();
+    m_updateTime = sf::Time::Zero;
+    m_drawTime = sf::Time::Zero;
+    m_statsFrames = 0;
+    m_statsTicks = 0;
+    m_statsTreeTicks = 0;
+
+    m_frameClock.restart();
+    m_slowestFrame = sf::Time::Zero;
+    m_slowFrames = 0;
+
+    std::cout << "Stress test on, " << m_workers.size() << " workers\n";
+}
+
+void WorkerManager::setUseTasks(bool useTasks, Map& map)
+{
+    if (useTasks == m_useTasks)
+        return;
+
+    // neither side can pick up where the other left off, everyone drops what they're doing
+    m_tasks.clear();
+    m_tasks.shrink_to_fit();
+    m_blackboards.clear();
+    m_blackboards.shrink_to_fit();
+    m_useTasks = useTasks;
+
+    for (int i = 0; i < static_cast<int>(m_workers.size()); ++i)
+    {
+        m_workers[i]->resetProgress();
+        insertBehaviour(i, map);
+    }
+
+    m_scheduler.resize(static_cast<int>(m_workers.size()));
+
+    std::cout << "Workers now run " << (m_useTasks ? "task scripts" : "the behaviour tree") << "\n";
+}
+
+void WorkerManager::printPathStats() const
+{
+    std::cout << "[Paths] " << m_tilesOpened << " tiles opened | " << m_pathRepairs << " fossil path repairs | avg "
+        << (m_pathRepairs > 0 ? static_cast<double>(m_pathRepairExpanded) / m_pathRepairs : 0.0) << " nodes re-expanded per repair\n";
+    m_pathService.printStats();
+    TaskFramePool::get().printStats();
+}
+
+void WorkerManager::reportStressStats()
+{
+    sf::Time elapsed = m_statsClock.getElapsedTime();
+
+    if (elapsed < sf::seconds(2.f))
+        return;
+
+    float seconds = elapsed.asSeconds();
+    float updateMs = m_statsTicks > 0 ? m_updateTime.asSeconds() * 1000.f / m_statsTicks : 0.f;
+    float drawMs = m_statsFrames > 0 ? m_drawTime.asSeconds() * 1000.f / m_statsFrames : 0.f;
+    float treesPerTick = m_statsTicks > 0 ? static_cast<float>(m_statsTreeTicks) / m_statsTicks : 0.f;
+    std::size_t taskBytes = m_workers.empty() ? 0 : TaskFramePool::get().getBytesInUse() / m_workers.size();
+
+    std::cout << "[Stress] " << m_workers.size() << " workers | "
+        << m_statsFrames / seconds << " fps | update " << updateMs << " ms/tick | draw " << drawMs << " ms/frame | " << treesPerTick << (m_useTasks ? " tasks" : " trees") << " run/tick, "
+        << m_scheduler.getSleepingCount() << " asleep | " << taskBytes << " task bytes/worker | " << m_pathService.getPendingCount() << " paths queued\n";
+
+    // the average hides hitches, so also say whether every frame made it inside 1/60 s
+    std::cout << "[Stress] slowest frame " << m_slowestFrame.asSeconds() * 1000.f << " ms | " << m_slowFrames << " of " << m_statsFrames
+        << " frames over 16.7 ms | " << (m_slowFrames == 0 ? "held 60 fps" : "below 60 fps") << "\n";
+
+    m_statsClock.restart();
+    m_updateTime = sf::Time::Zero;
+    m_drawTime = sf::Time::Zero;
+    m_statsFrames = 0;
+    m_statsTicks = 0;
+    m_statsTreeTicks = 0;
+    m_slowestFrame = sf::Time::Zero;
+    m_slowFrames = 0;
+}
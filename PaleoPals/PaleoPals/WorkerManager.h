@@ -0,0 +1,97 @@
+#pragma once
+#ifndef WORKER_MANAGER_H
+#define WORKER_MANAGER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include "NPC.h"
+#include "BehaviourTree.h"
+#include "BTScheduler.h"
+#include "WorkerTask.h"
+
+class Map;
+
+// number of free diggers the stress test adds on top of the hired ones
+const int STRESS_TEST_WORKERS = 500;
+
+// Owns every hired paleontologist, runs their task scripts (or the behaviour tree)
+// and draws them all with one vertex array and the shared character texture. Only
+// workers with something to do get run, the rest sleep in m_scheduler.
+class WorkerManager
+{
+public:
+    WorkerManager();
+
+    NPC& hire(sf::Vector2f spawnPosition, Map& map);
+    int getHiredCount() const { return m_hiredCount; }
+    int getWorkerCount() const { return static_cast<int>(m_workers.size()); }
+
+    void update(sf::Time dt, Map& map);
+    void draw(sf::RenderWindow& window, const sf::FloatRect& viewBounds);
+
+    // deepest tile row any worker is on, -1 with no workers
+    int getDeepestRow(Map& map) const;
+
+    // adds or removes STRESS_TEST_WORKERS unpaid diggers spread along the surface
+    void toggleStressTest(Map& map);
+    bool isStressTesting() const { return static_cast<int>(m_workers.size()) > m_hiredCount; }
+
+    PathService& getPathService() { return m_pathService; }
+
+    // task scripts by default, the tree from worker_tree.json otherwise. switching makes every worker start over
+    void setUseTasks(bool useTasks, Map& map);
+    bool isUsingTasks() const { return m_useTasks; }
+
+    // how much work path repair has done since the game started
+    void printPathStats() const;
+
+private:
+    std::unique_ptr<NPC> createWorker(sf::Vector2f spawnPosition);
+    // a task or a blackboard, whichever m_useTasks says is running
+    void insertBehaviour(int workerIndex, Map& map);
+    // a different rng seed for every task started, derived from the world seed
+    std::uint32_t nextTaskSeed(const Map& map);
+    void reportStressStats();
+
+    // declared before the workers so it outlives them, they cancel their tickets on the way out
+    PathService m_pathService;
+
+    // one tree for everybody, each worker's place in it lives in m_blackboards
+    BehaviourTree m_tree;
+
+    // hired workers first, stress test workers after them
+    std::vector<std::unique_ptr<NPC>> m_workers;
+    std::vector<BTSlot> m_blackboards;      // m_tree.getStateSize() slots per worker while the tree runs, same order as m_workers
+    int m_hiredCount = 0;
+
+    // one per worker while m_useTasks is on, declared after m_workers so they go first
+    std::vector<WorkerTask> m_tasks;
+    bool m_useTasks = true;
+    std::uint32_t m_tasksStarted = 0;
+
+    BTScheduler m_scheduler;                // same order as m_workers too
+    std::vector<PathTicket> m_finishedPaths;
+
+    std::shared_ptr<sf::Texture> m_texture;
+    sf::VertexArray m_vertices{ sf::PrimitiveType::Triangles };
+
+    // stress test timing, printed every couple of seconds
+    sf::Clock m_statsClock;
+    sf::Time m_updateTime;
+    sf::Time m_drawTime;
+    int m_statsFrames = 0;
+    int m_statsTicks = 0;
+    long long m_statsTreeTicks = 0;
+    // whole frame times measured draw to draw, so the report says whether 60 fps actually held
+    sf::Clock m_frameClock;
+    sf::Time m_slowestFrame;
+    int m_slowFrames = 0;
+
+    // path repair counters, one repair is one worker catching up on one tick's dug tiles
+    long long m_pathRepairs = 0;
+    long long m_pathRepairExpanded = 0;
+    long long m_tilesOpened = 0;
+};
+
+#endif // !WORKER_MANAGER_H
@@ -0,0 +1,148 @@
+#include "WorkerRoutines.h"
+#include "NPC.h"
+#include "Map.h"
+#include <algorithm>
+#include <iostream>
+
+WorkerTask runWorker(NPC& npc, Map& map, std::uint32_t seed)
+{
+    // lives in the frame, only a few bytes
+    std::minstd_rand rng(seed);
+
+    while (true)
+    {
+        co_await wanderSurface(npc, rng);
+        co_await digTiles(npc, map, MINING_PATH_LENGTH);
+        co_await returnToSurface(npc, map);
+        co_await collectFossils(npc, map);
+        co_await returnToSurface(npc, map);
+    }
+}
+
+WorkerTask wanderSurface(NPC& npc, std::minstd_rand& rng)
+{
+    // the walking happens in updateNPC, here it's just a roll a second
+    npc.m_wandering = true;
+
+    std::uniform_int_distribution<int> roll(0, 99);
+
+    do
+    {
+        co_await sleepFor(1.0f);
+    } while (roll(rng) >= 30);
+
+    npc.m_wandering = false;
+}
+
+WorkerTask digTiles(NPC& npc, Map& map, int tiles)
+{
+    // the whole trip fits in the frame
+    sf::Vector2i path[MINING_PATH_LENGTH];
+    int count = npc.planMiningPath(map, map.worldToTile(npc.getNPCPosition()), path, std::min(tiles, MINING_PATH_LENGTH));
+
+    float cooldown = 0.0f;
+
+    for (int i = 0; i < count; ++i)
+    {
+        sf::Vector2i tile = path[i];
+        std::uint32_t tileKey = static_cast<std::uint32_t>(tile.y * map.getColumnCount() + tile.x);
+
+        // swing until it breaks, sleeping in between unless someone else breaks it first
+        while (map.isSolid(tile.y, tile.x))
+        {
+            if (cooldown <= 0.0f)
+            {
+                npc.mineTile(map, tile);
+                cooldown = npc.npcMiningTickDelay;
+                continue;
+            }
+
+            cooldown -= co_await waitFor(BTEvent::TileBroken, tileKey, cooldown);
+        }
+
+        while (!npc.walkToTile(tile, co_await nextFrame(), map))
+        {
+        }
+    }
+}
+
+WorkerTask returnToSurface(NPC& npc, Map& map)
+{
+    // the map keeps the field up to date as tiles open, so there's no path to hold on to or repair
+    sf::Vector2i tile = map.worldToTile(npc.getNPCPosition());
+    sf::Vector2i next;
+    float stuckTime = 0.0f;
+
+    while (tile.y > 0 && map.getSurfaceDistance(tile.y, tile.x) != 0)
+    {
+        if (!map.stepTowardSurface(tile, next))
+        {
+            // sealed in, give someone a chance to dig a way through
+            if (stuckTime > 10.0f)
+            {
+                std::cout << "Return task TIMEOUT - NPC trapped underground for 10+ seconds!\n";
+                co_return;
+            }
+
+            stuckTime += co_await sleepFor(0.5f);
+            continue;
+        }
+
+        while (!npc.walkToTile(next, co_await nextFrame(), map))
+        {
+        }
+
+        tile = next;
+    }
+}
+
+WorkerTask collectFossils(NPC& npc, Map& map)
+{
+    FossilManager& fossils = map.getFossilManager();
+
+    while (true)
+    {
+        sf::Vector2i npcTile = map.worldToTile(npc.getNPCPosition());
+
+        CollectibleHandle target = fossils.findNearest(npc.getNPCPosition(), 1.0e9f, [&](const Collectible& collectible)
+            {
+                return map.isReachable(npcTile, { collectible.gridCol, collectible.gridRow });
+            });
+
+        Collectible* fossil = fossils.get(target);
+
+        // nothing left in reach
+        if (!fossil)
+            co_return;
+
+        npc.generateFossilPath(map, { fossil->gridCol, fossil->gridRow });
+
+        // gone before we got there means someone else picked it up, look for another
+        while ((fossil = fossils.get(target)) != nullptr)
+        {
+            sf::Vector2f diff = fossil->sprite.getPosition() - npc.getNPCPosition();
+
+            if (diff.x * diff.x + diff.y * diff.y < 16.0f * 16.0f)
+            {
+                fossils.removeCollectible(target);
+                break;
+            }
+
+            // path ran out short of it, leave it for the next trip
+            if (!npc.hasFossilRoute())
+                co_return;
+
+            PathTicket ticket = npc.getFossilTicket();
+
+            if (ticket != NO_PATH_TICKET)
+            {
+                // stand still until the path service answers, then pick the path up without moving
+                co_await waitFor(BTEvent::PathReady, ticket, 0.5f);
+                npc.updateFossilPath(sf::Time::Zero, map);
+                continue;
+            }
+
+            npc.updateFossilPath(sf::seconds(co_await nextFrame()), map);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#ifndef WORKER_ROUTINES_H
+#define WORKER_ROUTINES_H
+
+#include "WorkerTask.h"
+#include <cstdint>
+#include <random>
+
+class NPC;
+class Map;
+
+// The paleontologist's day as task scripts, the same loop as the default behaviour tree.
+// Progress lives in the task frames rather than the npc's paths and flags, the npc is only
+// asked to walk, swing and find fossil paths.
+
+// wander, dig, come back up, grab reachable fossils, come back up, forever.
+// seed starts the worker's own rng so workers don't share std::rand
+WorkerTask runWorker(NPC& npc, Map& map, std::uint32_t seed);
+
+// strolls along the surface until a roll sends the npc digging
+WorkerTask wanderSurface(NPC& npc, std::minstd_rand& rng);
+// digs out up to tiles tiles of a random dfs trip from where the npc stands
+WorkerTask digTiles(NPC& npc, Map& map, int tiles);
+// climbs the surface distance field a tile at a time, gives up after 10 seconds sealed in
+WorkerTask returnToSurface(NPC& npc, Map& map);
+// picks up fossils in reach until there are none left or a path to one runs out
+WorkerTask collectFossils(NPC& npc, Map& map);
+
+#endif // !WORKER_ROUTINES_H
@@ -0,0 +1,145 @@
+#include "WorkerTask.h"
+#include <iostream>
+#include <new>
+
+TaskFramePool& TaskFramePool::get()
+{
+    static TaskFramePool pool;
+    return pool;
+}
+
+TaskFramePool::~TaskFramePool()
+{
+    for (void* page : m_pages)
+    {
+        ::operator delete(page);
+    }
+}
+
+void* TaskFramePool::allocate(std::size_t size)
+{
+    m_bytesInUse += size;
+    ++m_framesInUse;
+
+    if (size > MAX_POOLED_FRAME)
+        return ::operator new(size);
+
+    std::size_t sizeClass = (size + FRAME_ALIGN - 1) / FRAME_ALIGN - 1;
+    std::size_t blockSize = (sizeClass + 1) * FRAME_ALIGN;
+
+    // out of blocks this size, carve a new page up into them
+    if (!m_freeLists[sizeClass])
+    {
+        char* page = static_cast<char*>(::operator new(blockSize * BLOCKS_PER_PAGE));
+        m_pages.push_back(page);
+        m_bytesReserved += blockSize * BLOCKS_PER_PAGE;
+
+        for (int i = BLOCKS_PER_PAGE - 1; i >= 0; --i)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(page + i * blockSize);
+            block->next = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = block;
+        }
+    }
+
+    FreeBlock* block = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block->next;
+
+    return block;
+}
+
+void TaskFramePool::release(void* frame, std::size_t size)
+{
+    m_bytesInUse -= size;
+    --m_framesInUse;
+
+    if (size > MAX_POOLED_FRAME)
+    {
+        ::operator delete(frame);
+        return;
+    }
+
+    std::size_t sizeClass = (size + FRAME_ALIGN - 1) / FRAME_ALIGN - 1;
+
+    FreeBlock* block = static_cast<FreeBlock*>(frame);
+    block->next = m_freeLists[sizeClass];
+    m_freeLists[sizeClass] = block;
+}
+
+void TaskFramePool::printStats() const
+{
+    std::cout << "[Tasks] " << m_framesInUse << " frames live | " << m_bytesInUse << " bytes in use | "
+        << m_bytesReserved << " bytes reserved in " << m_pages.size() << " pages\n";
+}
+
+std::coroutine_handle<> WorkerTask::FinalAwaiter::await_suspend(Handle finished) noexcept
+{
+    promise_type& promise = finished.promise();
+
+    if (promise.continuation)
+    {
+        promise.root->current = promise.continuation;
+        return promise.continuation;
+    }
+
+    // the root finished, back to whoever called resume
+    return std::noop_coroutine();
+}
+
+std::coroutine_handle<> WorkerTask::ChildAwaiter::await_suspend(Handle parent) noexcept
+{
+    promise_type& promise = child.promise();
+    promise.root = parent.promise().root;
+    promise.continuation = parent;
+    promise.root->current = child;
+
+    return child;
+}
+
+void WorkerTask::Suspend::await_suspend(Handle waiting) noexcept
+{
+    root = waiting.promise().root;
+    root->context->yield = yield;
+}
+
+WorkerTask::WorkerTask(WorkerTask&& other) noexcept
+    : m_handle(other.m_handle)
+{
+    other.m_handle = nullptr;
+}
+
+WorkerTask& WorkerTask::operator=(WorkerTask&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (m_handle)
+            m_handle.destroy();
+
+        m_handle = other.m_handle;
+        other.m_handle = nullptr;
+    }
+
+    return *this;
+}
+
+WorkerTask::~WorkerTask()
+{
+    // a child still running is a temporary in its parent's frame, so this takes the whole chain down
+    if (m_handle)
+        m_handle.destroy();
+}
+
+void WorkerTask::resume(BTTickContext& context)
+{
+    if (isDone())
+        return;
+
+    promise_type& root = m_handle.promise();
+    root.context = &context;
+    context.yield = BTYield();
+
+    if (!root.current)
+        root.current = m_handle;
+
+    root.current.resume();
+}
@@ -0,0 +1,150 @@
+#pragma once
+#ifndef WORKER_TASK_H
+#define WORKER_TASK_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <vector>
+#include "BTNode.h"
+
+// Hands out coroutine frames from fixed size blocks so starting a task never touches the heap
+// once the pool has warmed up. Sizes are rounded up to FRAME_ALIGN and each size keeps its own
+// free list, anything over MAX_POOLED_FRAME goes to the normal allocator. Main thread only.
+class TaskFramePool
+{
+public:
+    static TaskFramePool& get();
+
+    void* allocate(std::size_t size);
+    void release(void* frame, std::size_t size);
+
+    std::size_t getBytesInUse() const { return m_bytesInUse; }
+    int getFramesInUse() const { return m_framesInUse; }
+    void printStats() const;
+
+    static const std::size_t FRAME_ALIGN = 64;
+    static const std::size_t MAX_POOLED_FRAME = 1024;
+    static const int BLOCKS_PER_PAGE = 64;
+
+private:
+    TaskFramePool() = default;
+    ~TaskFramePool();
+    TaskFramePool(const TaskFramePool&) = delete;
+    TaskFramePool& operator=(const TaskFramePool&) = delete;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    FreeBlock* m_freeLists[MAX_POOLED_FRAME / FRAME_ALIGN] = {};
+    std::vector<void*> m_pages;
+    std::size_t m_bytesInUse = 0;
+    std::size_t m_bytesReserved = 0;
+    int m_framesInUse = 0;
+};
+
+// A worker routine written as straight line code. It suspends on co_await nextFrame(),
+// sleepFor() or waitFor() and is resumed by WorkerManager through the same BTScheduler
+// that ticks behaviour trees, so a sleeping task costs nothing until it's due. Tasks can
+// co_await other tasks, the outer one carries on once the inner one returns.
+class WorkerTask
+{
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // hands control back to whoever co_awaited the finished task
+    struct FinalAwaiter
+    {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle finished) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    struct promise_type
+    {
+        WorkerTask get_return_object() { return WorkerTask(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(std::size_t size) { return TaskFramePool::get().allocate(size); }
+        static void operator delete(void* frame, std::size_t size) { TaskFramePool::get().release(frame, size); }
+
+        promise_type* root = this;              // outermost task of the chain
+        std::coroutine_handle<> continuation;   // task waiting on this one
+
+        // only used on the root
+        std::coroutine_handle<> current;        // innermost task, where the next resume picks up
+        BTTickContext* context = nullptr;
+    };
+
+    // lets one task co_await another
+    struct ChildAwaiter
+    {
+        Handle child;
+
+        bool await_ready() const noexcept { return !child || child.done(); }
+        std::coroutine_handle<> await_suspend(Handle parent) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    // what nextFrame / sleepFor / waitFor hand back, resumes with the seconds since the task last ran
+    struct Suspend
+    {
+        BTYield yield;
+        promise_type* root = nullptr;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(Handle waiting) noexcept;
+        float await_resume() const noexcept { return root->context->elapsed; }
+    };
+
+    WorkerTask() = default;
+    WorkerTask(WorkerTask&& other) noexcept;
+    WorkerTask& operator=(WorkerTask&& other) noexcept;
+    WorkerTask(const WorkerTask&) = delete;
+    WorkerTask& operator=(const WorkerTask&) = delete;
+    ~WorkerTask();
+
+    // runs until the next suspend, context.yield says when it wants to run again
+    void resume(BTTickContext& context);
+    bool isDone() const { return !m_handle || m_handle.done(); }
+
+    ChildAwaiter operator co_await() && noexcept { return { m_handle }; }
+
+private:
+    explicit WorkerTask(Handle handle) : m_handle(handle) {}
+
+    Handle m_handle;
+};
+
+// carry on next frame
+inline WorkerTask::Suspend nextFrame()
+{
+    return {};
+}
+
+// nothing to do for this long
+inline WorkerTask::Suspend sleepFor(float seconds)
+{
+    WorkerTask::Suspend suspend;
+    suspend.yield.sleepFor = seconds;
+    return suspend;
+}
+
+// sleep until event / key is posted, or timeout seconds at most (0 waits for the event however long it takes)
+inline WorkerTask::Suspend waitFor(BTEvent event, std::uint32_t key, float timeout)
+{
+    WorkerTask::Suspend suspend;
+    suspend.yield.sleepFor = timeout;
+    suspend.yield.waitForEvent = true;
+    suspend.yield.event = event;
+    suspend.yield.eventKey = key;
+    return suspend;
+}
+
+#endif // !WORKER_TASK_H
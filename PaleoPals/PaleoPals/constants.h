@@ -5,6 +5,9 @@ const int WINDOW_X = 1800;
 const int WINDOW_Y = 900;
 const int BACKGROUND_LENGTH = 5264;
 
+// tiles a worker digs on one trip down
+const int MINING_PATH_LENGTH = 10;
+
 
 enum class GameState
 {
@@ -15,4 +18,16 @@ enum class GameState
     Paused,
     Settings,
     Exit
-};
\ No newline at end of file
+};
+
+// half-open block of tiles [firstRow, lastRow) x [firstCol, lastCol), e.g. the part of the grid a view can see
+struct TileRange
+{
+    int firstRow = 0;
+    int lastRow = 0;
+    int firstCol = 0;
+    int lastCol = 0;
+
+    bool isEmpty() const { return firstRow >= lastRow || firstCol >= lastCol; }
+    bool contains(int row, int col) const { return row >= firstRow && row < lastRow && col >= firstCol && col < lastCol; }
+};
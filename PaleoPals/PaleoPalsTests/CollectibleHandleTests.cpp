@@ -0,0 +1,122 @@
+#include "TestRunner.h"
+#include "Fossil.h"
+#include "TextureAtlas.h"
+
+namespace
+{
+    // a blank sheet is enough, the tests only care about slots and handles
+    struct TestFossils
+    {
+        TextureAtlas atlas;
+        FossilManager fossils;
+
+        TestFossils()
+        {
+            DinosaurData dinosaur;
+            dinosaur.name = "Test";
+            dinosaur.pieces.push_back({ "skull", "" });
+            fossils.loadFossilsFromConfig({ CollectibleType{ 0, "bone", "fossil", "" } }, { dinosaur });
+
+            atlas.addImage("collectibles", sf::Image({ 64 * 12, 64 }, sf::Color::White));
+            atlas.build();
+            fossils.useAtlas(atlas);
+            fossils.cacheGridOffsets(0.f, 0.f, 32.f);
+            fossils.setSpawnChance(100);
+        }
+
+        CollectibleHandle spawn(int row, int col)
+        {
+            fossils.trySpawnCollectible(row, col, 32.f, 800.f, 600.f);
+            return fossils.getHandle(row, col);
+        }
+    };
+}
+
+TEST(handleResolvesUntilItsCollectibleIsRemoved)
+{
+    TestFossils test;
+    CollectibleHandle handle = test.spawn(3, 4);
+
+    CHECK(handle.isValid());
+    Collectible* collectible = test.fossils.get(handle);
+    CHECK(collectible != nullptr);
+    CHECK(collectible && collectible->gridRow == 3 && collectible->gridCol == 4);
+
+    test.fossils.removeCollectible(handle);
+
+    CHECK(test.fossils.get(handle) == nullptr);
+    CHECK(!test.fossils.getHandle(3, 4).isValid());
+    CHECK(test.fossils.getTotalCollectibleCount() == 0);
+
+    // removing twice is harmless
+    test.fossils.removeCollectible(handle);
+    CHECK(test.fossils.getTotalCollectibleCount() == 0);
+}
+
+TEST(reusedSlotGetsANewGeneration)
+{
+    TestFossils test;
+    CollectibleHandle first = test.spawn(1, 1);
+    test.fossils.removeCollectible(first);
+
+    CollectibleHandle second = test.spawn(9, 2);
+
+    // same slot, but the old handle must not see the new collectible
+    CHECK(second.index == first.index);
+    CHECK(second.generation != first.generation);
+    CHECK(second != first);
+    CHECK(test.fossils.get(first) == nullptr);
+
+    Collectible* collectible = test.fossils.get(second);
+    CHECK(collectible && collectible->gridRow == 9 && collectible->gridCol == 2);
+}
+
+TEST(staleHandlesStayStaleThroughChurn)
+{
+    TestFossils test;
+    std::vector<CollectibleHandle> live;
+    std::vector<CollectibleHandle> removed;
+
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            live.push_back(test.spawn(round, i));
+        }
+
+        // drop every other one so slots are handed out again next round
+        for (size_t i = 0; i < live.size(); i += 2)
+        {
+            test.fossils.removeCollectible(live[i]);
+            removed.push_back(live[i]);
+        }
+
+        std::vector<CollectibleHandle> kept;
+        for (size_t i = 1; i < live.size(); i += 2)
+        {
+            kept.push_back(live[i]);
+        }
+        live.swap(kept);
+    }
+
+    for (const CollectibleHandle& handle : removed)
+    {
+        CHECK(test.fossils.get(handle) == nullptr);
+    }
+
+    for (const CollectibleHandle& handle : live)
+    {
+        CHECK(test.fossils.get(handle) != nullptr);
+    }
+
+    CHECK(test.fossils.getTotalCollectibleCount() == static_cast<int>(live.size()));
+}
+
+TEST(defaultHandleNeverResolves)
+{
+    TestFossils test;
+    test.spawn(0, 0);
+
+    CHECK(!CollectibleHandle().isValid());
+    CHECK(test.fossils.get(CollectibleHandle()) == nullptr);
+}
@@ -0,0 +1,169 @@
+#include "TestRunner.h"
+#include "TestGrid.h"
+#include "DStarLite.h"
+#include <algorithm>
+
+namespace
+{
+    // D* Lite only searches the rows around start and goal, so the reference bfs gets the same band
+    int windowDistance(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, sf::Vector2i planStart)
+    {
+        int firstRow = std::max(0, std::min(planStart.y, goal.y) - DSTAR_WINDOW_MARGIN);
+        int lastRow = std::min(grid.rows, std::max(planStart.y, goal.y) + DSTAR_WINDOW_MARGIN + 1);
+        return bfsDistance(grid, start, goal, firstRow, lastRow);
+    }
+
+    // digs up to count random solid tiles, returning the ones it opened
+    std::vector<sf::Vector2i> digRandom(TestGrid& grid, std::mt19937& gen, int count)
+    {
+        std::uniform_int_distribution<int> rowRoll(0, grid.rows - 1);
+        std::uniform_int_distribution<int> colRoll(0, grid.cols - 1);
+        std::vector<sf::Vector2i> opened;
+
+        for (int i = 0; i < count; ++i)
+        {
+            int row = rowRoll(gen);
+            int col = colRoll(gen);
+
+            if (!grid.view().isOpen(row, col))
+            {
+                grid.setSolid(row, col, false);
+                opened.push_back({ col, row });
+            }
+        }
+
+        return opened;
+    }
+}
+
+TEST(dStarLitePlanMatchesBfs)
+{
+    std::mt19937 gen(3);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        TestGrid grid(60, 20);
+        grid.fillRandom(gen, 45);
+
+        sf::Vector2i start(gen() % 20, gen() % 60);
+        sf::Vector2i goal(gen() % 20, gen() % 60);
+        grid.setSolid(start.y, start.x, false);
+        grid.setSolid(goal.y, goal.x, false);
+
+        DStarLite planner;
+        bool found = planner.plan(grid.view(), start, goal);
+        int expected = windowDistance(grid.view(), start, goal, start);
+
+        CHECK(found == (expected >= 0));
+        if (found)
+        {
+            std::vector<sf::Vector2i> path;
+            CHECK(planner.extractPath(grid.view(), path));
+            CHECK(static_cast<int>(path.size()) == expected);
+            CHECK(isWalkablePath(grid.view(), start, goal, path));
+        }
+    }
+}
+
+TEST(dStarLiteRepairMatchesAFreshPlan)
+{
+    // digging only ever opens tiles, after each batch the repaired path has to be as
+    // short as planning again from nothing
+    std::mt19937 gen(11);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        TestGrid grid(60, 20);
+        grid.fillRandom(gen, 45);
+
+        sf::Vector2i start(gen() % 20, gen() % 60);
+        sf::Vector2i goal(gen() % 20, gen() % 60);
+        grid.setSolid(start.y, start.x, false);
+        grid.setSolid(goal.y, goal.x, false);
+
+        DStarLite planner;
+        bool planned = planner.plan(grid.view(), start, goal);
+
+        for (int batch = 0; batch < 5; ++batch)
+        {
+            std::vector<sf::Vector2i> opened = digRandom(grid, gen, 4);
+            bool repaired = planner.repair(grid.view(), start, opened);
+
+            DStarLite fresh;
+            bool freshFound = fresh.plan(grid.view(), start, goal);
+
+            // a plan that failed stays failed, the npc goes the long way instead
+            if (!planned)
+            {
+                CHECK(repaired == (windowDistance(grid.view(), start, goal, start) >= 0));
+                break;
+            }
+
+            CHECK(repaired == freshFound);
+            if (repaired && freshFound)
+            {
+                std::vector<sf::Vector2i> path;
+                std::vector<sf::Vector2i> freshPath;
+                CHECK(planner.extractPath(grid.view(), path));
+                CHECK(fresh.extractPath(grid.view(), freshPath));
+                CHECK(path.size() == freshPath.size());
+                CHECK(isWalkablePath(grid.view(), start, goal, path));
+            }
+        }
+    }
+}
+
+TEST(dStarLiteRepairFollowsAMovingStart)
+{
+    std::mt19937 gen(29);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        TestGrid grid(60, 20);
+        grid.fillRandom(gen, 40);
+
+        sf::Vector2i start(gen() % 20, gen() % 60);
+        sf::Vector2i goal(gen() % 20, gen() % 60);
+        grid.setSolid(start.y, start.x, false);
+        grid.setSolid(goal.y, goal.x, false);
+
+        DStarLite planner;
+        std::vector<sf::Vector2i> path;
+
+        if (!planner.plan(grid.view(), start, goal) || !planner.extractPath(grid.view(), path))
+            continue;
+
+        sf::Vector2i planStart = start;
+
+        // walk a few steps between digs like an npc would
+        while (path.size() > 3)
+        {
+            start = path[2];
+
+            std::vector<sf::Vector2i> opened = digRandom(grid, gen, 3);
+            CHECK(planner.repair(grid.view(), start, opened));
+            CHECK(planner.extractPath(grid.view(), path));
+            CHECK(static_cast<int>(path.size()) == windowDistance(grid.view(), start, goal, planStart));
+            CHECK(isWalkablePath(grid.view(), start, goal, path));
+        }
+    }
+}
+
+TEST(dStarLiteIgnoresDiggingOutsideItsWindow)
+{
+    TestGrid grid(100, 20);
+    std::mt19937 gen(4);
+    grid.fillRandom(gen, 30);
+
+    sf::Vector2i start(2, 2);
+    sf::Vector2i goal(17, 5);
+    grid.setSolid(start.y, start.x, false);
+    grid.setSolid(goal.y, goal.x, false);
+
+    DStarLite planner;
+    planner.plan(grid.view(), start, goal);
+
+    // far below anything the band covers
+    grid.setSolid(90, 10, false);
+    CHECK(!planner.isAffectedBy({ { 10, 90 } }));
+}
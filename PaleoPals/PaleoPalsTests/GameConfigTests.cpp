@@ -0,0 +1,158 @@
+#include "TestRunner.h"
+#include "GameConfig.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    const char* TEST_JSON = R"({
+  "map": {
+    "layers": [
+      {"name": "Topsoil", "texture": "top.png", "hardness": 1},
+      {"name": "Bedrock", "texture": "bed.png", "hardness": 9}
+    ],
+    "cracks": {"texture": "cracks.png", "frameWidth": 20, "frameHeight": 22, "frames": 4},
+    "seed": 1234567890123
+  },
+  "museum": {"texture": "museum.png", "frameWidth": 160, "frameHeight": 113, "position": {"x": 1600, "y": 338}},
+  "trader": {"texture": "trader.png", "frameWidth": 161, "frameHeight": 91, "position": {"x": 25.5, "y": 361}},
+  "collectibles": [
+    {"index": 0, "name": "Fossil_Fragment", "type": "fossil", "texture": "sheet.png", "frameWidth": 64, "frameHeight": 64, "frameIndex": 0, "monetaryValue": 40},
+    {"index": 1, "name": "Amber", "type": "amber", "texture": "sheet.png", "frameWidth": 32, "frameHeight": 48, "frameIndex": 7, "monetaryValue": 75}
+  ],
+  "dinosaurs": [
+    {"name": "Raptor", "category": "Theropod", "background": "bg.png", "skinTexture": "skin.png",
+     "pieces": [{"id": "skull", "texture": "skull.png"}, {"id": "tail", "texture": "tail.png"}]}
+  ]
+})";
+
+    std::string writeTestJson(const std::string& name)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove(path.string() + ".bin");
+
+        std::ofstream file(path, std::ios::binary);
+        file << TEST_JSON;
+        return path.string();
+    }
+
+    bool sameBuilding(const BuildingConfig& a, const BuildingConfig& b)
+    {
+        return a.texture == b.texture && a.frameWidth == b.frameWidth && a.frameHeight == b.frameHeight && a.position == b.position;
+    }
+
+    bool sameConfig(const GameConfig& a, const GameConfig& b)
+    {
+        if (a.map.layers.size() != b.map.layers.size() || a.collectibles.size() != b.collectibles.size() || a.dinosaurs.size() != b.dinosaurs.size())
+            return false;
+
+        for (size_t i = 0; i < a.map.layers.size(); ++i)
+        {
+            const LayerType& x = a.map.layers[i];
+            const LayerType& y = b.map.layers[i];
+            if (x.name != y.name || x.texturePath != y.texturePath || x.hardness != y.hardness)
+                return false;
+        }
+
+        const CrackConfig& cracksA = a.map.cracks;
+        const CrackConfig& cracksB = b.map.cracks;
+        if (cracksA.texture != cracksB.texture || cracksA.frameWidth != cracksB.frameWidth || cracksA.frameHeight != cracksB.frameHeight || cracksA.frames != cracksB.frames)
+            return false;
+
+        if (a.map.hasSeed != b.map.hasSeed || a.map.seed != b.map.seed)
+            return false;
+
+        if (a.hasMuseum != b.hasMuseum || !sameBuilding(a.museum, b.museum) || a.hasTrader != b.hasTrader || !sameBuilding(a.trader, b.trader))
+            return false;
+
+        for (size_t i = 0; i < a.collectibles.size(); ++i)
+        {
+            const CollectibleType& x = a.collectibles[i];
+            const CollectibleType& y = b.collectibles[i];
+            if (x.index != y.index || x.name != y.name || x.type != y.type || x.texture != y.texture || x.frameWidth != y.frameWidth
+                || x.frameHeight != y.frameHeight || x.frameIndex != y.frameIndex || x.monetaryValue != y.monetaryValue)
+                return false;
+        }
+
+        for (size_t i = 0; i < a.dinosaurs.size(); ++i)
+        {
+            const DinosaurData& x = a.dinosaurs[i];
+            const DinosaurData& y = b.dinosaurs[i];
+            if (x.name != y.name || x.category != y.category || x.backgroundTexture != y.backgroundTexture || x.skinTexture != y.skinTexture
+                || x.pieces.size() != y.pieces.size())
+                return false;
+
+            for (size_t p = 0; p < x.pieces.size(); ++p)
+            {
+                if (x.pieces[p].id != y.pieces[p].id || x.pieces[p].texturePath != y.pieces[p].texturePath)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+TEST(configJsonIsParsedAndCached)
+{
+    std::string jsonPath = writeTestJson("paleopals_config_parse.json");
+
+    GameConfig config;
+    CHECK(config.loadFromFile(jsonPath));
+    CHECK(std::filesystem::exists(jsonPath + ".bin"));
+
+    CHECK(config.map.layers.size() == 2);
+    CHECK(config.map.layers.size() == 2 && config.map.layers[1].hardness == 9);
+    CHECK(config.map.hasSeed && config.map.seed == 1234567890123ull);
+    CHECK(config.hasTrader && config.trader.position == sf::Vector2f(25.5f, 361.f));
+    CHECK(config.dinosaurs.size() == 1 && config.dinosaurs[0].pieces.size() == 2);
+}
+
+TEST(configCacheRoundTripsEveryField)
+{
+    std::string jsonPath = writeTestJson("paleopals_config_roundtrip.json");
+
+    GameConfig parsed;
+    CHECK(parsed.loadFromFile(jsonPath));
+
+    // scramble the JSON but keep its size and timestamp, so only the cache can give the right answer
+    auto stamp = std::filesystem::last_write_time(jsonPath);
+    std::string scrambled(std::filesystem::file_size(jsonPath), '#');
+    {
+        std::ofstream file(jsonPath, std::ios::binary | std::ios::trunc);
+        file << scrambled;
+    }
+    std::filesystem::last_write_time(jsonPath, stamp);
+
+    GameConfig cached;
+    CHECK(cached.loadFromFile(jsonPath));
+    CHECK(sameConfig(parsed, cached));
+}
+
+TEST(truncatedConfigCacheFallsBackToJson)
+{
+    std::string jsonPath = writeTestJson("paleopals_config_truncated.json");
+    std::string cachePath = jsonPath + ".bin";
+
+    GameConfig parsed;
+    CHECK(parsed.loadFromFile(jsonPath));
+
+    std::uintmax_t fullSize = std::filesystem::file_size(cachePath);
+    CHECK(fullSize > 32);
+
+    // cut inside the header, inside a count, inside a string and one byte short of the end
+    const std::uintmax_t cuts[] = { 0, 3, 12, 24, fullSize / 3, fullSize / 2, fullSize - 1 };
+
+    for (std::uintmax_t cut : cuts)
+    {
+        std::filesystem::resize_file(cachePath, cut);
+
+        GameConfig reloaded;
+        CHECK(reloaded.loadFromFile(jsonPath));
+        CHECK(sameConfig(parsed, reloaded));
+
+        // a bad cache is replaced by a good one
+        CHECK(std::filesystem::file_size(cachePath) == fullSize);
+    }
+}
@@ -0,0 +1,110 @@
+#include "TestRunner.h"
+#include "TestGrid.h"
+#include "GridAStar.h"
+
+TEST(gridAStarMatchesBfsOnRandomGrids)
+{
+    std::mt19937 gen(2024);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        TestGrid grid(30 + i % 20, 20 + i % 70);
+        grid.fillRandom(gen, 35);
+
+        std::uniform_int_distribution<int> rowRoll(0, grid.rows - 1);
+        std::uniform_int_distribution<int> colRoll(0, grid.cols - 1);
+        sf::Vector2i start(colRoll(gen), rowRoll(gen));
+        sf::Vector2i goal(colRoll(gen), rowRoll(gen));
+        grid.setSolid(start.y, start.x, false);
+        grid.setSolid(goal.y, goal.x, false);
+
+        GridAStar search;
+        std::vector<sf::Vector2i> path;
+        bool found = search.findPath(grid.view(), start, goal, path);
+        int expected = bfsDistance(grid.view(), start, goal);
+
+        CHECK(found == (expected >= 0));
+        if (found)
+        {
+            CHECK(static_cast<int>(path.size()) == expected);
+            CHECK(isWalkablePath(grid.view(), start, goal, path));
+        }
+    }
+}
+
+TEST(gridAStarReusesItsBuffersBetweenQueries)
+{
+    // the stamps have to hide the last query's costs, whatever size grid came before
+    std::mt19937 gen(5);
+    GridAStar search;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        TestGrid grid(10 + (i * 7) % 40, 10 + (i * 13) % 40);
+        grid.fillRandom(gen, 30);
+
+        sf::Vector2i start(0, 0);
+        sf::Vector2i goal(grid.cols - 1, grid.rows - 1);
+        grid.setSolid(start.y, start.x, false);
+        grid.setSolid(goal.y, goal.x, false);
+
+        std::vector<sf::Vector2i> path;
+        bool found = search.findPath(grid.view(), start, goal, path);
+        int expected = bfsDistance(grid.view(), start, goal);
+
+        CHECK(found == (expected >= 0));
+        CHECK(!found || static_cast<int>(path.size()) == expected);
+    }
+}
+
+TEST(gridAStarSlicedSearchMatchesTheWholeSearch)
+{
+    std::mt19937 gen(77);
+    TestGrid grid(60, 60);
+    grid.fillRandom(gen, 30);
+
+    sf::Vector2i start(1, 1);
+    sf::Vector2i goal(58, 58);
+    grid.setSolid(start.y, start.x, false);
+    grid.setSolid(goal.y, goal.x, false);
+
+    GridAStar whole;
+    std::vector<sf::Vector2i> wholePath;
+    bool found = whole.findPath(grid.view(), start, goal, wholePath);
+
+    GridAStar sliced;
+    sliced.begin(grid.view(), start, goal);
+
+    SearchStatus status = SearchStatus::Running;
+    int slices = 0;
+    while (status == SearchStatus::Running && slices < 10000)
+    {
+        status = sliced.step(grid.view(), 7);
+        ++slices;
+    }
+
+    CHECK(status == (found ? SearchStatus::Found : SearchStatus::Failed));
+    CHECK(slices > 1);
+
+    if (found)
+    {
+        std::vector<sf::Vector2i> slicedPath;
+        sliced.getPath(slicedPath);
+        CHECK(slicedPath.size() == wholePath.size());
+        CHECK(isWalkablePath(grid.view(), start, goal, slicedPath));
+    }
+}
+
+TEST(gridAStarFailsIntoSolidOrOffTheGrid)
+{
+    TestGrid grid(10, 10);
+    grid.setSolid(5, 5, true);
+
+    GridAStar search;
+    std::vector<sf::Vector2i> path;
+
+    CHECK(!search.findPath(grid.view(), { 0, 0 }, { 5, 5 }, path));
+    CHECK(!search.findPath(grid.view(), { 0, 0 }, { 10, 3 }, path));
+    CHECK(!search.findPath(grid.view(), { -1, 0 }, { 3, 3 }, path));
+    CHECK(path.empty());
+}
@@ -0,0 +1,113 @@
+#include "TestRunner.h"
+#include "GridTraversal.h"
+#include <random>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    const float TILE = 32.f;
+
+    bool isNeighbour(sf::Vector2i a, sf::Vector2i b)
+    {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y) == 1;
+    }
+
+    // cells hit by sampling the segment very finely, can miss a cell only clipped at a corner
+    std::vector<sf::Vector2i> sampleCells(sf::Vector2f start, sf::Vector2f end)
+    {
+        std::vector<sf::Vector2i> cells;
+        const int samples = 20000;
+
+        for (int i = 0; i <= samples; ++i)
+        {
+            sf::Vector2f point = start + (end - start) * (static_cast<float>(i) / samples);
+            sf::Vector2i cell(static_cast<int>(std::floor(point.x / TILE)), static_cast<int>(std::floor(point.y / TILE)));
+
+            if (cells.empty() || cells.back() != cell)
+                cells.push_back(cell);
+        }
+
+        return cells;
+    }
+}
+
+TEST(traverseStaysInOneCellForAShortSegment)
+{
+    std::vector<sf::Vector2i> cells;
+    traverseGridCells({ 40.f, 40.f }, { 50.f, 60.f }, TILE, 10, 10, cells);
+
+    CHECK(cells.size() == 1);
+    CHECK(!cells.empty() && cells[0] == sf::Vector2i(1, 1));
+}
+
+TEST(traverseWalksAlongARow)
+{
+    std::vector<sf::Vector2i> cells;
+    traverseGridCells({ 16.f, 80.f }, { 16.f + TILE * 5, 80.f }, TILE, 10, 10, cells);
+
+    CHECK(cells.size() == 6);
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        CHECK(cells[i] == sf::Vector2i(static_cast<int>(i), 2));
+    }
+}
+
+TEST(traverseWalksBackwardsUpAColumn)
+{
+    std::vector<sf::Vector2i> cells;
+    traverseGridCells({ 100.f, 300.f }, { 100.f, 10.f }, TILE, 20, 20, cells);
+
+    CHECK(cells.size() == 10);
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        CHECK(cells[i] == sf::Vector2i(3, 9 - static_cast<int>(i)));
+    }
+}
+
+TEST(traverseMatchesFineSamplingOnRandomSegments)
+{
+    std::mt19937 gen(99);
+    std::uniform_real_distribution<float> coord(0.f, TILE * 40.f);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        sf::Vector2f start(coord(gen), coord(gen));
+        sf::Vector2f end(coord(gen), coord(gen));
+
+        std::vector<sf::Vector2i> cells;
+        traverseGridCells(start, end, TILE, 40, 40, cells);
+        std::vector<sf::Vector2i> sampled = sampleCells(start, end);
+
+        CHECK(!cells.empty());
+        if (cells.empty())
+            continue;
+
+        // starts and ends where the segment does and never skips diagonally
+        CHECK(cells.front() == sampled.front());
+        CHECK(cells.back() == sampled.back());
+
+        for (size_t c = 1; c < cells.size(); ++c)
+        {
+            CHECK(isNeighbour(cells[c - 1], cells[c]));
+        }
+
+        // everything sampling found shows up, in the same order
+        size_t next = 0;
+        for (const sf::Vector2i& cell : cells)
+        {
+            if (next < sampled.size() && sampled[next] == cell)
+                ++next;
+        }
+        CHECK(next == sampled.size());
+    }
+}
+
+TEST(traverseOnlyReportsCellsInsideTheGrid)
+{
+    std::vector<sf::Vector2i> cells;
+    traverseGridCells({ -3.f * TILE, 16.f }, { 3.5f * TILE, 16.f }, TILE, 4, 2, cells);
+
+    CHECK(cells.size() == 2);
+    CHECK(cells.size() == 2 && cells[0] == sf::Vector2i(0, 0) && cells[1] == sf::Vector2i(1, 0));
+}
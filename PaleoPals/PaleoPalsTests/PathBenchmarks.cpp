@@ -0,0 +1,149 @@
+#include "PathBenchmarks.h"
+#include "GridAStar.h"
+#include "HierarchicalPathfinder.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <vector>
+
+void runGridAStarBenchmark(int size, int queries)
+{
+    // roughly a dug out level, a quarter of the tiles left solid, same layout every run
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> roll(0.f, 1.f);
+    std::uniform_int_distribution<int> cellRoll(0, size - 1);
+
+    int wordsPerRow = (size + 63) / 64;
+    std::vector<std::uint64_t> bits(static_cast<size_t>(size) * wordsPerRow, 0);
+
+    for (int row = 0; row < size; ++row)
+    {
+        for (int col = 0; col < size; ++col)
+        {
+            if (roll(gen) < 0.25f)
+                bits[static_cast<size_t>(row) * wordsPerRow + (col >> 6)] |= 1ull << (col & 63);
+        }
+    }
+
+    SolidGridView grid{ bits.data(), wordsPerRow, size, size };
+
+    auto randomOpenTile = [&]()
+        {
+            sf::Vector2i tile;
+            do
+            {
+                tile = sf::Vector2i(cellRoll(gen), cellRoll(gen));
+            } while (!grid.isOpen(tile.y, tile.x));
+            return tile;
+        };
+
+    std::vector<std::pair<sf::Vector2i, sf::Vector2i>> pairs;
+    pairs.reserve(queries);
+
+    for (int i = 0; i < queries; ++i)
+    {
+        pairs.push_back({ randomOpenTile(), randomOpenTile() });
+    }
+
+    GridAStar pathfinder;
+    std::vector<sf::Vector2i> path;
+
+    // first query grows the buffers, keep it out of the timing
+    pathfinder.findPath(grid, pairs[0].first, pairs[0].second, path);
+
+    int foundCount = 0;
+    long long expanded = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (const auto& query : pairs)
+    {
+        if (pathfinder.findPath(grid, query.first, query.second, path))
+            ++foundCount;
+        expanded += pathfinder.getLastExpanded();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "[A* benchmark] " << size << "x" << size << " grid, " << queries << " queries in "
+        << seconds * 1000.0 << " ms | " << queries / seconds << " queries/sec | "
+        << foundCount << " found | avg " << expanded / queries << " nodes expanded\n";
+}
+
+void runHierarchicalBenchmark(int rows, int cols, int queries)
+{
+    // a deep site of long galleries joined by shafts at alternating ends, with caves dotted around
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<float> roll(0.f, 1.f);
+
+    int wordsPerRow = (cols + 63) / 64;
+    std::vector<std::uint64_t> bits(static_cast<size_t>(rows) * wordsPerRow, ~0ull);
+
+    auto open = [&](int row, int col)
+        {
+            bits[static_cast<size_t>(row) * wordsPerRow + (col >> 6)] &= ~(1ull << (col & 63));
+        };
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int col = 0; col < cols; ++col)
+        {
+            bool gallery = row % 6 == 0;
+            bool shaft = (row / 6) % 2 == 0 ? col == cols - 1 : col == 0;
+
+            if (gallery || shaft || roll(gen) < 0.3f)
+                open(row, col);
+        }
+    }
+
+    SolidGridView grid{ bits.data(), wordsPerRow, rows, cols };
+
+    // endpoints on the galleries so every query is reachable
+    std::uniform_int_distribution<int> galleryRoll(0, (rows - 1) / 6);
+    std::uniform_int_distribution<int> colRoll(0, cols - 1);
+
+    std::vector<std::pair<sf::Vector2i, sf::Vector2i>> pairs;
+    for (int i = 0; i < queries; ++i)
+    {
+        pairs.push_back({ { colRoll(gen), galleryRoll(gen) * 6 }, { colRoll(gen), galleryRoll(gen) * 6 } });
+    }
+
+    std::vector<sf::Vector2i> path;
+
+    GridAStar flat;
+    long long flatExpanded = 0;
+    long long flatLength = 0;
+    flat.findPath(grid, pairs[0].first, pairs[0].second, path);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& query : pairs)
+    {
+        flat.findPath(grid, query.first, query.second, path);
+        flatExpanded += flat.getLastExpanded();
+        flatLength += path.size();
+    }
+    double flatSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    HierarchicalPathfinder hierarchical;
+    long long hierExpanded = 0;
+    long long hierLength = 0;
+
+    begin = std::chrono::steady_clock::now();
+    hierarchical.resize(rows, cols);
+    hierarchical.rebuildDirtyChunks(grid);
+    double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    begin = std::chrono::steady_clock::now();
+    for (const auto& query : pairs)
+    {
+        hierarchical.findPath(grid, query.first, query.second, path);
+        hierExpanded += hierarchical.getLastExpanded();
+        hierLength += path.size();
+    }
+    double hierSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << "[HPA* benchmark] " << rows << "x" << cols << " dig site, " << queries << " queries\n"
+        << "  A*   : " << queries / flatSeconds << " queries/sec | avg " << flatExpanded / queries << " nodes expanded\n"
+        << "  HPA* : " << queries / hierSeconds << " queries/sec | avg " << hierExpanded / queries << " nodes expanded | graph built in "
+        << buildSeconds * 1000.0 << " ms | paths " << (flatLength > 0 ? 100.0 * (hierLength - flatLength) / flatLength : 0.0) << "% longer\n";
+}
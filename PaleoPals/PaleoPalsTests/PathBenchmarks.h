@@ -0,0 +1,14 @@
+#pragma once
+#ifndef PATH_BENCHMARKS_H
+#define PATH_BENCHMARKS_H
+
+// timings for the pathfinders on synthetic grids, run with PaleoPalsTests --bench.
+// kept out of the game so none of this ships with it
+
+// random queries on a size x size grid, prints queries per second
+void runGridAStarBenchmark(int size = 1000, int queries = 200);
+
+// long queries down a deep winding dig site, hierarchical against plain A*
+void runHierarchicalBenchmark(int rows = 2000, int cols = 75, int queries = 200);
+
+#endif // !PATH_BENCHMARKS_H
@@ -0,0 +1,123 @@
+#include "TestRunner.h"
+#include "SolidGrid.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+    // 150 cols spreads every row over three words, the last one only partly used
+    const int ROWS = 40;
+    const int COLS = 150;
+
+    struct TestGrid
+    {
+        int wordsPerRow = (COLS + 63) / 64;
+        std::vector<std::uint64_t> bits = std::vector<std::uint64_t>(static_cast<size_t>(ROWS) * wordsPerRow, 0);
+        std::vector<bool> solid = std::vector<bool>(static_cast<size_t>(ROWS) * COLS, false);
+
+        void setSolid(int row, int col)
+        {
+            bits[static_cast<size_t>(row) * wordsPerRow + (col >> 6)] |= 1ull << (col & 63);
+            solid[static_cast<size_t>(row) * COLS + col] = true;
+        }
+
+        SolidGridView view() const { return SolidGridView{ bits.data(), wordsPerRow, ROWS, COLS }; }
+    };
+
+    TestGrid makeRandomGrid(unsigned seed, int solidPercent)
+    {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> roll(0, 99);
+        TestGrid grid;
+
+        for (int row = 0; row < ROWS; ++row)
+        {
+            for (int col = 0; col < COLS; ++col)
+            {
+                if (roll(gen) < solidPercent)
+                    grid.setSolid(row, col);
+            }
+        }
+
+        return grid;
+    }
+}
+
+TEST(countSolidInRowMatchesCountingTileByTile)
+{
+    TestGrid grid = makeRandomGrid(7, 40);
+    SolidGridView view = grid.view();
+
+    // every span including ones that start or stop on a word boundary
+    for (int row = 0; row < ROWS; row += 3)
+    {
+        for (int first = 0; first <= COLS; first += 7)
+        {
+            for (int last = first; last <= COLS; last += 5)
+            {
+                int expected = 0;
+                for (int col = first; col < last; ++col)
+                {
+                    if (grid.solid[static_cast<size_t>(row) * COLS + col])
+                        ++expected;
+                }
+
+                CHECK(view.countSolidInRow(row, first, last) == expected);
+            }
+        }
+
+        CHECK(view.countSolidInRow(row, 64, 128) == view.countSolidInRow(row, 64, 100) + view.countSolidInRow(row, 100, 128));
+    }
+}
+
+TEST(countSolidInRowClampsToTheGrid)
+{
+    TestGrid grid;
+    grid.setSolid(2, 0);
+    grid.setSolid(2, COLS - 1);
+    SolidGridView view = grid.view();
+
+    CHECK(view.countSolidInRow(2, -10, COLS + 10) == 2);
+    CHECK(view.countSolidInRow(2, 5, 5) == 0);
+    CHECK(view.countSolidInRow(2, 10, 3) == 0);
+    CHECK(view.countSolidInRow(-1, 0, COLS) == 0);
+    CHECK(view.countSolidInRow(ROWS, 0, COLS) == 0);
+}
+
+TEST(firstSolidBelowMatchesScanningDown)
+{
+    TestGrid grid = makeRandomGrid(11, 10);
+    SolidGridView view = grid.view();
+
+    for (int col = 0; col < COLS; ++col)
+    {
+        for (int row = -2; row < ROWS; ++row)
+        {
+            int expected = -1;
+            for (int r = std::max(row, 0); r < ROWS; ++r)
+            {
+                if (grid.solid[static_cast<size_t>(r) * COLS + col])
+                {
+                    expected = r;
+                    break;
+                }
+            }
+
+            CHECK(view.firstSolidBelow(row, col) == expected);
+        }
+    }
+}
+
+TEST(firstSolidBelowIsMinusOneOutsideOrInOpenColumns)
+{
+    TestGrid grid;
+    grid.setSolid(5, 70);
+    SolidGridView view = grid.view();
+
+    CHECK(view.firstSolidBelow(0, 70) == 5);
+    CHECK(view.firstSolidBelow(5, 70) == 5);
+    CHECK(view.firstSolidBelow(6, 70) == -1);
+    CHECK(view.firstSolidBelow(0, 69) == -1);
+    CHECK(view.firstSolidBelow(0, -1) == -1);
+    CHECK(view.firstSolidBelow(0, COLS) == -1);
+}
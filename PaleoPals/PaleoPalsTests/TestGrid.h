@@ -0,0 +1,106 @@
+#pragma once
+#ifndef TEST_GRID_H
+#define TEST_GRID_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <deque>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include "SolidGrid.h"
+
+// solid bitset laid out like Map's, for the path tests to dig in
+struct TestGrid
+{
+    int rows = 0;
+    int cols = 0;
+    int wordsPerRow = 0;
+    std::vector<std::uint64_t> bits;
+
+    TestGrid(int rowCount, int colCount)
+        : rows(rowCount), cols(colCount), wordsPerRow((colCount + 63) / 64), bits(static_cast<size_t>(rowCount) * wordsPerRow, 0)
+    {
+    }
+
+    void setSolid(int row, int col, bool solid)
+    {
+        std::uint64_t& word = bits[static_cast<size_t>(row) * wordsPerRow + (col >> 6)];
+        std::uint64_t bit = 1ull << (col & 63);
+        word = solid ? (word | bit) : (word & ~bit);
+    }
+
+    SolidGridView view() const { return SolidGridView{ bits.data(), wordsPerRow, rows, cols }; }
+
+    void fillRandom(std::mt19937& gen, int solidPercent)
+    {
+        std::uniform_int_distribution<int> roll(0, 99);
+
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                setSolid(row, col, roll(gen) < solidPercent);
+            }
+        }
+    }
+};
+
+// plain breadth first search for the true step count, -1 if unreachable. rows outside
+// [firstRow, lastRow) count as solid so searches limited to a band can be checked too
+inline int bfsDistance(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, int firstRow = 0, int lastRow = -1)
+{
+    if (lastRow < 0)
+        lastRow = grid.rows;
+
+    std::vector<int> distance(static_cast<size_t>(grid.rows) * grid.cols, -1);
+    std::deque<int> queue;
+
+    distance[start.y * grid.cols + start.x] = 0;
+    queue.push_back(start.y * grid.cols + start.x);
+
+    const int rowStep[4] = { 0, 0, 1, -1 };
+    const int colStep[4] = { 1, -1, 0, 0 };
+
+    while (!queue.empty())
+    {
+        int cell = queue.front();
+        queue.pop_front();
+
+        for (int i = 0; i < 4; ++i)
+        {
+            int row = cell / grid.cols + rowStep[i];
+            int col = cell % grid.cols + colStep[i];
+
+            if (row < firstRow || row >= lastRow || !grid.isOpen(row, col))
+                continue;
+
+            int next = row * grid.cols + col;
+
+            if (distance[next] < 0)
+            {
+                distance[next] = distance[cell] + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    return distance[goal.y * grid.cols + goal.x];
+}
+
+// every step goes to an open 4 neighbour, starting next to start and finishing on goal
+inline bool isWalkablePath(const SolidGridView& grid, sf::Vector2i start, sf::Vector2i goal, const std::vector<sf::Vector2i>& path)
+{
+    sf::Vector2i previous = start;
+
+    for (const sf::Vector2i& tile : path)
+    {
+        if (std::abs(tile.x - previous.x) + std::abs(tile.y - previous.y) != 1 || !grid.isOpen(tile.y, tile.x))
+            return false;
+        previous = tile;
+    }
+
+    return previous == goal;
+}
+
+#endif // !TEST_GRID_H
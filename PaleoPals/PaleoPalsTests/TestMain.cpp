@@ -0,0 +1,49 @@
+/// <summary>
+/// unit tests for the game's grid, path and data code, built against the game's own sources.
+/// PaleoPalsTests runs every test, PaleoPalsTests --bench runs the path benchmarks instead
+/// </summary>
+
+#ifdef _DEBUG 
+#pragma comment(lib,"sfml-graphics-d.lib") 
+#pragma comment(lib,"sfml-system-d.lib") 
+#pragma comment(lib,"sfml-window-d.lib") 
+#else 
+#pragma comment(lib,"sfml-graphics.lib") 
+#pragma comment(lib,"sfml-system.lib") 
+#pragma comment(lib,"sfml-window.lib") 
+#endif 
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include "TestRunner.h"
+#include "PathBenchmarks.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+    {
+        runGridAStarBenchmark();
+        runHierarchicalBenchmark();
+        return EXIT_SUCCESS;
+    }
+
+    int failedTests = 0;
+
+    for (const TestCase& test : getTests())
+    {
+        int failedBefore = getFailedChecks();
+        test.run();
+
+        bool passed = getFailedChecks() == failedBefore;
+        if (!passed)
+            ++failedTests;
+
+        std::cout << (passed ? "[pass] " : "[FAIL] ") << test.name << "\n";
+    }
+
+    int total = static_cast<int>(getTests().size());
+    std::cout << total - failedTests << "/" << total << " tests passed\n";
+
+    return failedTests == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef TEST_RUNNER_H
+#define TEST_RUNNER_H
+
+#include <iostream>
+#include <vector>
+
+// just enough of a test framework to not need one installed. TEST registers itself before
+// main runs, a CHECK that fails prints where and carries on so one run shows everything broken
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<TestCase>& getTests()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+inline int& getFailedChecks()
+{
+    static int failed = 0;
+    return failed;
+}
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*run)()) { getTests().push_back({ name, run }); }
+};
+
+#define TEST(name) \
+    static void name(); \
+    static TestRegistrar name##Registrar(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            ++getFailedChecks(); \
+            std::cout << "    " << __FILE__ << ":" << __LINE__ << " CHECK(" << #condition << ") failed\n"; \
+        } \
+    } while (false)
+
+#endif // !TEST_RUNNER_H
@@ -0,0 +1,157 @@
+#include "TestRunner.h"
+#include "TestGrid.h"
+#include "TileComponents.h"
+
+namespace
+{
+    // starts fully solid and digs tiles one at a time, keeping the bitset and the components in step
+    struct DigSite
+    {
+        TestGrid grid;
+        TileComponents components;
+
+        DigSite(int rows, int cols)
+            : grid(rows, cols)
+        {
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int col = 0; col < cols; ++col)
+                {
+                    grid.setSolid(row, col, true);
+                }
+            }
+
+            components.resize(rows, cols);
+        }
+
+        void dig(int row, int col)
+        {
+            grid.setSolid(row, col, false);
+            components.open(row, col);
+        }
+    };
+
+    // what isReachable promises, spelled out with a bfs
+    bool bfsReachable(const SolidGridView& grid, sf::Vector2i from, sf::Vector2i to)
+    {
+        if (!grid.isOpen(to.y, to.x))
+            return false;
+
+        if (grid.isOpen(from.y, from.x))
+            return bfsDistance(grid, from, to) >= 0;
+
+        bool insideGrid = from.y >= 0 && from.x >= 0 && from.y < grid.rows && from.x < grid.cols;
+
+        if (!insideGrid)
+            return false;
+
+        const sf::Vector2i steps[4] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+
+        for (const sf::Vector2i& step : steps)
+        {
+            sf::Vector2i side = from + step;
+
+            if (grid.isOpen(side.y, side.x) && bfsDistance(grid, side, to) >= 0)
+                return true;
+        }
+
+        return false;
+    }
+}
+
+TEST(tileComponentsMatchBfsWhileDigging)
+{
+    std::mt19937 gen(8);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        DigSite site(24, 30);
+        std::uniform_int_distribution<int> rowRoll(0, site.grid.rows - 1);
+        std::uniform_int_distribution<int> colRoll(0, site.grid.cols - 1);
+
+        for (int dig = 0; dig < 400; ++dig)
+        {
+            site.dig(rowRoll(gen), colRoll(gen));
+
+            if (dig % 20 != 0)
+                continue;
+
+            for (int query = 0; query < 20; ++query)
+            {
+                sf::Vector2i from(colRoll(gen), rowRoll(gen));
+                sf::Vector2i to(colRoll(gen), rowRoll(gen));
+
+                CHECK(site.components.isReachable(site.grid.view(), from, to) == bfsReachable(site.grid.view(), from, to));
+            }
+        }
+    }
+}
+
+TEST(tileComponentsJoinPocketsThroughTheTileBeingDug)
+{
+    DigSite site(5, 7);
+
+    // two pockets either side of a one tile wall
+    site.dig(2, 1);
+    site.dig(2, 2);
+    site.dig(2, 4);
+    site.dig(2, 5);
+
+    SolidGridView grid = site.grid.view();
+    CHECK(site.components.getComponent(2, 1) == site.components.getComponent(2, 2));
+    CHECK(site.components.getComponent(2, 1) != site.components.getComponent(2, 5));
+    CHECK(!site.components.isReachable(grid, { 1, 2 }, { 5, 2 }));
+
+    // a worker stood in the wall tile still counts as touching both sides
+    CHECK(site.components.isReachable(grid, { 3, 2 }, { 5, 2 }));
+    CHECK(site.components.isReachable(grid, { 3, 2 }, { 1, 2 }));
+
+    // but not from a solid tile with no open side
+    CHECK(!site.components.isReachable(grid, { 3, 0 }, { 1, 2 }));
+
+    site.dig(2, 3);
+    CHECK(site.components.isReachable(site.grid.view(), { 1, 2 }, { 5, 2 }));
+    CHECK(site.components.getComponent(2, 1) == site.components.getComponent(2, 5));
+}
+
+TEST(tileComponentsRejectSolidAndOutsideTargets)
+{
+    DigSite site(4, 4);
+    site.dig(0, 0);
+
+    SolidGridView grid = site.grid.view();
+    CHECK(site.components.getComponent(1, 1) == -1);
+    CHECK(site.components.getComponent(-1, 0) == -1);
+    CHECK(site.components.getComponent(0, 4) == -1);
+    CHECK(!site.components.isReachable(grid, { 0, 0 }, { 1, 1 }));
+    CHECK(!site.components.isReachable(grid, { 0, 0 }, { 9, 9 }));
+    CHECK(!site.components.isReachable(grid, { -1, 0 }, { 0, 0 }));
+    CHECK(site.components.isReachable(grid, { 0, 0 }, { 0, 0 }));
+}
+
+TEST(tileComponentsKeepSetsWhenRowsAreAppended)
+{
+    // streamed generation grows the grid downwards, existing pockets have to survive it
+    DigSite site(4, 6);
+    site.dig(3, 2);
+    site.dig(2, 2);
+
+    TestGrid deeper(8, 6);
+    for (int row = 0; row < 8; ++row)
+    {
+        for (int col = 0; col < 6; ++col)
+        {
+            deeper.setSolid(row, col, row >= 4 || !site.grid.view().isOpen(row, col));
+        }
+    }
+
+    site.grid = deeper;
+    site.components.resize(8, 6);
+
+    CHECK(site.components.getComponent(2, 2) == site.components.getComponent(3, 2));
+    CHECK(site.components.getComponent(5, 2) == -1);
+
+    site.dig(4, 2);
+    site.dig(5, 2);
+    CHECK(site.components.isReachable(site.grid.view(), { 2, 2 }, { 2, 5 }));
+}